@@ -0,0 +1,457 @@
+#ifndef RECTANGULAR_BOUNDARY_COLLISION_AABB_TREE_HPP
+#define RECTANGULAR_BOUNDARY_COLLISION_AABB_TREE_HPP
+
+#include "RectangularBoundaryCollision.hpp"
+
+namespace collision
+{
+
+// dynamic AABB tree (bounding volume hierarchy) for objects that persist over many frames
+// each object is a leaf of a binary tree; each node's bounding box contains the bounding boxes of all of its children
+//     queries only visit the nodes whose bounding boxes overlap what is being queried so their cost does not depend on how objects' sizes vary
+// the bounding boxes stored in the tree are "fattened" (expanded by fatMargin) so an object that moves only slightly stays where it is in the tree
+//     only an object that moves outside of its fattened bounding box is removed and reinserted
+// objects are inserted next to the node that increases the total perimeter of the tree the least (surface area heuristic)
+//     and the nodes above are then rotated when that reduces the total perimeter further, which keeps the tree balanced
+// T is the type of the objects; they can be any objects that can be tested with areColliding
+// the objects are not copied so they must stay alive while they are in the tree
+// each object is identified by the proxy ID returned by insert; proxy IDs of removed objects can be reused
+// queries (const methods) can be made from multiple threads at once as long as the tree is not changed at the same time
+//     except for findCollisions of all pairs, which records the number of candidate pairs (see getNumberOfCandidatePairs)
+template <class T>
+class AabbTree
+{
+public:
+	static constexpr std::size_t nullProxy{ static_cast<std::size_t>(-1) };
+
+	float fatMargin{ 4.f }; // applies to objects when they are (re)inserted
+
+	std::size_t insert(const T& object)
+	{
+		const std::size_t proxyId{ allocateNode() };
+		m_leaves[proxyId].object = &object;
+		updateLeaf(proxyId);
+		m_nodes[proxyId].bounds = getFattenedBounds(m_leaves[proxyId].proxy.bounds);
+		insertLeaf(proxyId);
+		++m_numberOfObjects;
+		return proxyId;
+	}
+	void remove(const std::size_t proxyId)
+	{
+		removeLeaf(proxyId);
+		freeNode(proxyId);
+		--m_numberOfObjects;
+	}
+	// must be called when the object changes (moves, rotates, scales etc.)
+	// returns true if the object has moved outside of its fattened bounding box (and so has been reinserted)
+	bool move(const std::size_t proxyId)
+	{
+		updateLeaf(proxyId);
+		if (contains(m_nodes[proxyId].bounds, m_leaves[proxyId].proxy.bounds))
+			return false;
+		removeLeaf(proxyId);
+		m_nodes[proxyId].bounds = getFattenedBounds(m_leaves[proxyId].proxy.bounds);
+		insertLeaf(proxyId);
+		return true;
+	}
+	void clear()
+	{
+		m_nodes.clear();
+		m_leaves.clear();
+		m_freeNodes.clear();
+		m_root = nullNode;
+		m_numberOfObjects = 0u;
+	}
+	const T& getObject(const std::size_t proxyId) const
+	{
+		return *m_leaves[proxyId].object;
+	}
+	sf::FloatRect getFattenedBounds(const std::size_t proxyId) const
+	{
+		const Bounds& bounds{ m_nodes[proxyId].bounds };
+		return { bounds.topLeft, bounds.bottomRight - bounds.topLeft };
+	}
+	std::size_t getNumberOfObjects() const
+	{
+		return m_numberOfObjects;
+	}
+	// height of the tree (0 if empty or if it only has one object)
+	std::size_t getHeight() const
+	{
+		return (m_root == nullNode) ? 0u : static_cast<std::size_t>(m_nodes[m_root].height);
+	}
+
+	// collisions are the proxy IDs of each colliding pair, sorted by first and then by second
+	// collision level is the same as for areColliding
+	void findCollisions(std::vector<Pair>& collisions, const int collisionLevel = -1) const
+	{
+		collisions.clear();
+		m_numberOfCandidatePairs = 0u;
+		std::vector<std::size_t> stack;
+		for (std::size_t proxyId{ 0u }; proxyId < m_nodes.size(); ++proxyId)
+		{
+			if (m_nodes[proxyId].height != 0)
+				continue;
+			const CollisionProxy& proxy{ m_leaves[proxyId].proxy };
+			forEachOverlappingLeaf(stack, proxy.bounds, [&](const std::size_t otherProxyId)
+			{
+				if (otherProxyId <= proxyId)
+					return;
+				const CollisionProxy& otherProxy{ m_leaves[otherProxyId].proxy };
+				if (!impl::areBoundsIntersecting(proxy.bounds, otherProxy.bounds))
+					return;
+				++m_numberOfCandidatePairs;
+				if ((collisionLevel == 0) || impl::areCollidingBeyondLevel0(proxy, otherProxy, collisionLevel))
+					collisions.push_back({ proxyId, otherProxyId });
+			});
+		}
+		std::sort(collisions.begin(), collisions.end(), [](const Pair& a, const Pair& b) { return (a.first < b.first) || ((a.first == b.first) && (a.second < b.second)); });
+	}
+	// proxy IDs (sorted) of the objects in the tree that collide with the object (which does not need to be in the tree)
+	template <class U>
+	void findCollisions(const U& object, std::vector<std::size_t>& proxyIds, const int collisionLevel = -1) const
+	{
+		proxyIds.clear();
+		const CollisionProxy objectProxy(object);
+		std::vector<std::size_t> stack;
+		forEachOverlappingLeaf(stack, objectProxy.bounds, [&](const std::size_t proxyId)
+		{
+			if (areColliding(objectProxy, m_leaves[proxyId].proxy, collisionLevel))
+				proxyIds.push_back(proxyId);
+		});
+		std::sort(proxyIds.begin(), proxyIds.end());
+	}
+	// proxy IDs (sorted) of the objects that contain the point (see isContainingPoint)
+	void findObjectsContainingPoint(const sf::Vector2f point, std::vector<std::size_t>& proxyIds) const
+	{
+		proxyIds.clear();
+		std::vector<std::size_t> stack;
+		forEachOverlappingLeaf(stack, { point, { 0.f, 0.f } }, [&](const std::size_t proxyId)
+		{
+			if (isContainingPoint(m_leaves[proxyId].proxy, point))
+				proxyIds.push_back(proxyId);
+		});
+		std::sort(proxyIds.begin(), proxyIds.end());
+	}
+	// proxy IDs (sorted) of the objects that collide with the (axis-aligned) rectangle
+	void findObjectsInRect(const sf::FloatRect& rectangle, std::vector<std::size_t>& proxyIds, const int collisionLevel = -1) const
+	{
+		findCollisions(impl::RectangleObject{ rectangle }, proxyIds, collisionLevel);
+	}
+	// finds the first object hit by the ray (a line segment from start to end)
+	// returns false if no object is hit
+	bool findFirstHit(const sf::Vector2f start, const sf::Vector2f end, RayHit& hit) const
+	{
+		bool isHit{ false };
+		float closestFraction{ 1.f };
+		if (m_root == nullNode)
+			return false;
+		std::vector<std::size_t> stack{ m_root };
+		while (!stack.empty())
+		{
+			const std::size_t nodeIndex{ stack.back() };
+			stack.pop_back();
+			const Node& node{ m_nodes[nodeIndex] };
+			float fraction;
+			if (!impl::rayHitsRectangle(node.bounds.topLeft, node.bounds.bottomRight, start, end, fraction, closestFraction))
+				continue;
+			if (node.height != 0)
+			{
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+				continue;
+			}
+			const CollisionProxy& proxy{ m_leaves[nodeIndex].proxy };
+			if (!impl::rayHitsRectangle(proxy.bounds, start, end, fraction, closestFraction) ||
+				!impl::rayHitsRectangle(proxy.localBounds, proxy.inverseTransform.transformPoint(start), proxy.inverseTransform.transformPoint(end), fraction, closestFraction))
+				continue;
+			// ties go to the lowest proxy ID so that the result does not depend on the shape of the tree
+			if (isHit && (fraction == closestFraction) && (nodeIndex > hit.index))
+				continue;
+			isHit = true;
+			closestFraction = fraction;
+			hit.index = nodeIndex;
+		}
+		if (isHit)
+		{
+			hit.fraction = closestFraction;
+			hit.point = start + ((end - start) * closestFraction);
+		}
+		return isHit;
+	}
+	// number of pairs (from the most recent findCollisions of all pairs) whose bounding boxes intersect, i.e. the pairs that were tested further
+	std::size_t getNumberOfCandidatePairs() const
+	{
+		return m_numberOfCandidatePairs;
+	}
+
+private:
+	static constexpr std::size_t nullNode{ nullProxy };
+
+	// stored as corners (rather than position and size) so that unions are exact
+	struct Bounds
+	{
+		sf::Vector2f topLeft;
+		sf::Vector2f bottomRight;
+	};
+	struct Node
+	{
+		Bounds bounds; // fattened for leaves
+		std::size_t parent;
+		std::size_t child1;
+		std::size_t child2;
+		int height; // 0 for leaves, -1 for free nodes
+	};
+	struct Leaf
+	{
+		const T* object;
+		CollisionProxy proxy; // updated when the object is inserted or moved
+	};
+
+	std::vector<Node> m_nodes{};
+	std::vector<Leaf> m_leaves{}; // same indices as nodes (only used for leaves)
+	std::vector<std::size_t> m_freeNodes{};
+	std::size_t m_root{ nullNode };
+	std::size_t m_numberOfObjects{ 0u };
+	mutable std::size_t m_numberOfCandidatePairs{ 0u };
+
+	static float getPerimeter(const Bounds& bounds)
+	{
+		return 2.f * ((bounds.bottomRight.x - bounds.topLeft.x) + (bounds.bottomRight.y - bounds.topLeft.y));
+	}
+	static Bounds getUnion(const Bounds& bounds1, const Bounds& bounds2)
+	{
+		return { { std::min(bounds1.topLeft.x, bounds2.topLeft.x), std::min(bounds1.topLeft.y, bounds2.topLeft.y) }, { std::max(bounds1.bottomRight.x, bounds2.bottomRight.x), std::max(bounds1.bottomRight.y, bounds2.bottomRight.y) } };
+	}
+	static bool contains(const Bounds& outer, const sf::FloatRect& inner)
+	{
+		return (inner.position.x >= outer.topLeft.x) && (inner.position.y >= outer.topLeft.y) &&
+			((inner.position.x + inner.size.x) <= outer.bottomRight.x) && ((inner.position.y + inner.size.y) <= outer.bottomRight.y);
+	}
+	// includes bounds that only touch (these may still contain intersecting leaves since leaves' bounds are fattened)
+	static bool areOverlapping(const Bounds& bounds1, const sf::FloatRect& bounds2)
+	{
+		return (bounds1.topLeft.x <= (bounds2.position.x + bounds2.size.x)) && (bounds2.position.x <= bounds1.bottomRight.x) &&
+			(bounds1.topLeft.y <= (bounds2.position.y + bounds2.size.y)) && (bounds2.position.y <= bounds1.bottomRight.y);
+	}
+	Bounds getFattenedBounds(const sf::FloatRect& bounds) const
+	{
+		const sf::Vector2f margin{ fatMargin, fatMargin };
+		return { bounds.position - margin, bounds.position + bounds.size + margin };
+	}
+
+	// stack is the caller's (so that queries do not share any state); it is empty afterwards and can be reused
+	template <class Function>
+	void forEachOverlappingLeaf(std::vector<std::size_t>& stack, const sf::FloatRect& bounds, Function function) const
+	{
+		if (m_root == nullNode)
+			return;
+		stack.push_back(m_root);
+		while (!stack.empty())
+		{
+			const Node& node{ m_nodes[stack.back()] };
+			const std::size_t nodeIndex{ stack.back() };
+			stack.pop_back();
+			if (!areOverlapping(node.bounds, bounds))
+				continue;
+			if (node.height == 0)
+				function(nodeIndex);
+			else
+			{
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+
+	void updateLeaf(const std::size_t proxyId)
+	{
+		m_leaves[proxyId].proxy.update(*m_leaves[proxyId].object);
+	}
+
+	std::size_t allocateNode()
+	{
+		std::size_t nodeIndex;
+		if (!m_freeNodes.empty())
+		{
+			nodeIndex = m_freeNodes.back();
+			m_freeNodes.pop_back();
+		}
+		else
+		{
+			nodeIndex = m_nodes.size();
+			m_nodes.emplace_back();
+			m_leaves.emplace_back();
+		}
+		m_nodes[nodeIndex] = { {}, nullNode, nullNode, nullNode, 0 };
+		return nodeIndex;
+	}
+	void freeNode(const std::size_t nodeIndex)
+	{
+		m_nodes[nodeIndex].height = -1;
+		m_leaves[nodeIndex].object = nullptr;
+		m_freeNodes.push_back(nodeIndex);
+	}
+
+	void insertLeaf(const std::size_t leaf)
+	{
+		if (m_root == nullNode)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = nullNode;
+			return;
+		}
+
+		// find the best sibling (the node whose replacement by a new parent of it and the leaf increases the total perimeter the least)
+		const Bounds leafBounds{ m_nodes[leaf].bounds };
+		std::size_t sibling{ m_root };
+		while (m_nodes[sibling].height > 0)
+		{
+			const Node& node{ m_nodes[sibling] };
+			const float combinedPerimeter{ getPerimeter(getUnion(node.bounds, leafBounds)) };
+			const float cost{ 2.f * combinedPerimeter }; // cost of making a new parent of this node and the leaf
+			const float inheritanceCost{ 2.f * (combinedPerimeter - getPerimeter(node.bounds)) }; // cost of pushing the leaf further down
+			const auto getChildCost = [&](const std::size_t child)
+			{
+				const Node& childNode{ m_nodes[child] };
+				const float childCombinedPerimeter{ getPerimeter(getUnion(childNode.bounds, leafBounds)) };
+				return ((childNode.height == 0) ? childCombinedPerimeter : (childCombinedPerimeter - getPerimeter(childNode.bounds))) + inheritanceCost;
+			};
+			const float cost1{ getChildCost(node.child1) };
+			const float cost2{ getChildCost(node.child2) };
+			if ((cost < cost1) && (cost < cost2))
+				break;
+			sibling = (cost1 < cost2) ? node.child1 : node.child2;
+		}
+
+		// create a new parent of the sibling and the leaf
+		const std::size_t oldParent{ m_nodes[sibling].parent };
+		const std::size_t newParent{ allocateNode() };
+		m_nodes[newParent].parent = oldParent;
+		m_nodes[newParent].child1 = sibling;
+		m_nodes[newParent].child2 = leaf;
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+		if (oldParent == nullNode)
+			m_root = newParent;
+		else
+			replaceChild(oldParent, sibling, newParent);
+
+		refitAncestors(newParent);
+	}
+	void removeLeaf(const std::size_t leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = nullNode;
+			return;
+		}
+
+		// the leaf's sibling replaces their parent
+		const std::size_t parent{ m_nodes[leaf].parent };
+		const std::size_t grandparent{ m_nodes[parent].parent };
+		const std::size_t sibling{ (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1 };
+		m_nodes[sibling].parent = grandparent;
+		freeNode(parent);
+		if (grandparent == nullNode)
+		{
+			m_root = sibling;
+			return;
+		}
+		replaceChild(grandparent, parent, sibling);
+		refitAncestors(grandparent);
+	}
+	void replaceChild(const std::size_t parent, const std::size_t oldChild, const std::size_t newChild)
+	{
+		if (m_nodes[parent].child1 == oldChild)
+			m_nodes[parent].child1 = newChild;
+		else
+			m_nodes[parent].child2 = newChild;
+	}
+	// recalculates the node's bounds and height from its children
+	void refit(const std::size_t nodeIndex)
+	{
+		Node& node{ m_nodes[nodeIndex] };
+		node.bounds = getUnion(m_nodes[node.child1].bounds, m_nodes[node.child2].bounds);
+		node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+	}
+	void refitAncestors(std::size_t nodeIndex)
+	{
+		while (nodeIndex != nullNode)
+		{
+			rotate(nodeIndex);
+			refit(nodeIndex);
+			nodeIndex = m_nodes[nodeIndex].parent;
+		}
+	}
+	// swaps two nodes (and their subtrees) that are in different places in the tree (neither can be an ancestor of the other)
+	void swapNodes(const std::size_t nodeIndex1, const std::size_t nodeIndex2)
+	{
+		const std::size_t parent1{ m_nodes[nodeIndex1].parent };
+		const std::size_t parent2{ m_nodes[nodeIndex2].parent };
+		replaceChild(parent1, nodeIndex1, nodeIndex2);
+		replaceChild(parent2, nodeIndex2, nodeIndex1);
+		m_nodes[nodeIndex1].parent = parent2;
+		m_nodes[nodeIndex2].parent = parent1;
+	}
+	// swaps a child and a grandchild of the node (or two grandchildren) if that reduces the total perimeter of its children
+	// the node itself is not refitted
+	void rotate(const std::size_t nodeIndex)
+	{
+		const Node& node{ m_nodes[nodeIndex] };
+		if (node.height < 2)
+			return;
+		const std::size_t b{ node.child1 };
+		const std::size_t c{ node.child2 };
+		const bool isBInternal{ m_nodes[b].height > 0 };
+		const bool isCInternal{ m_nodes[c].height > 0 };
+		const float perimeterB{ isBInternal ? getPerimeter(m_nodes[b].bounds) : 0.f };
+		const float perimeterC{ isCInternal ? getPerimeter(m_nodes[c].bounds) : 0.f };
+
+		// b has children d and e; c has children f and g
+		std::size_t bestNode1{ nullNode };
+		std::size_t bestNode2{ nullNode };
+		float bestCost{ perimeterB + perimeterC };
+		const auto consider = [&](const std::size_t node1, const std::size_t node2, const float cost)
+		{
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestNode1 = node1;
+				bestNode2 = node2;
+			}
+		};
+		if (isCInternal)
+		{
+			const std::size_t f{ m_nodes[c].child1 };
+			const std::size_t g{ m_nodes[c].child2 };
+			consider(b, f, perimeterB + getPerimeter(getUnion(m_nodes[b].bounds, m_nodes[g].bounds)));
+			consider(b, g, perimeterB + getPerimeter(getUnion(m_nodes[b].bounds, m_nodes[f].bounds)));
+		}
+		if (isBInternal)
+		{
+			const std::size_t d{ m_nodes[b].child1 };
+			const std::size_t e{ m_nodes[b].child2 };
+			consider(c, d, perimeterC + getPerimeter(getUnion(m_nodes[c].bounds, m_nodes[e].bounds)));
+			consider(c, e, perimeterC + getPerimeter(getUnion(m_nodes[c].bounds, m_nodes[d].bounds)));
+			if (isCInternal)
+			{
+				const std::size_t f{ m_nodes[c].child1 };
+				const std::size_t g{ m_nodes[c].child2 };
+				consider(d, f, getPerimeter(getUnion(m_nodes[f].bounds, m_nodes[e].bounds)) + getPerimeter(getUnion(m_nodes[d].bounds, m_nodes[g].bounds)));
+				consider(d, g, getPerimeter(getUnion(m_nodes[g].bounds, m_nodes[e].bounds)) + getPerimeter(getUnion(m_nodes[f].bounds, m_nodes[d].bounds)));
+			}
+		}
+		if (bestNode1 == nullNode)
+			return;
+
+		swapNodes(bestNode1, bestNode2);
+		if (isBInternal)
+			refit(b);
+		if (isCInternal)
+			refit(c);
+	}
+};
+
+} // namespace collision
+#endif // RECTANGULAR_BOUNDARY_COLLISION_AABB_TREE_HPP
@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////////
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017-2026 M.J.Silk
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//
+//       ------------
+//       INTRODUCTION
+//       ------------
+//
+//   Creates many rectangles that move around the window (bouncing off its edges) and rotate.
+//   Every frame, all of the colliding pairs are found. Rectangles that collide with any other rectangle are coloured red, otherwise they are coloured green.
+//   The colliding pairs can be found in one of these ways (toggled by pressing SPACE):
+//     - brute force: every pair is tested with collision::areColliding
+//     - spatial hash: collision::SpatialHash only tests pairs that share a cell (and whose bounding boxes intersect); it is given pointers to the rectangles rather than the rectangles themselves
+//     - AABB tree: collision::AabbTree keeps the rectangles in a tree of bounding boxes (each rectangle is updated in the tree every frame)
+//     - sweep and prune: collision::SweepAndPrune keeps the edges of the rectangles' bounding boxes sorted from one frame to the next; it is also given pointers to the rectangles
+//     - parallel narrow phase: collision::SpatialHash only finds the pairs whose bounding boxes intersect (level 0) and collision::ParallelNarrowPhase tests those pairs across multiple threads (reading the rectangles through pointers)
+//   The window title shows the time taken to find the colliding pairs as well as the number of colliding pairs.
+//
+//
+//       --------
+//       CONTROLS
+//       --------
+//
+//   SPACE			        toggle broad phase method (starts with brute force)
+//   ESC                    quit
+//
+//
+//       -------------
+//       CUSTOMISATION
+//       -------------
+//
+//   You can change the number of rectangles using this line: constexpr std::size_t numberOfObjects{ 3000u };
+//   You can change the size of the spatial hash's cells using this line: collision::SpatialHash spatialHash(32.f);
+//
+//
+//        ----
+//        NOTE
+//        ----
+//
+//    If the window is too large (1920u, 1080u) for your resolution, you can uncomment the following define line to halve the window size (to 960x540): #define HALVE_WINDOW_SIZE
+//    You may also need to adjust the path of the included headers ("RectangularBoundaryCollision.hpp", "AabbTree.hpp", "SweepAndPrune.hpp" and "ParallelNarrowPhase.hpp") depending on your approach.
+//    "ParallelNarrowPhase.hpp" includes "WorkerPool.hpp" from the WorkerPool folder (in the root folder).
+//    Remember to test in both debug and release modes for comparisons.
+// 
+//    This example is for use with SFML 3.
+//
+//
+////////////////////////////////////////////////////////////////
+
+
+
+#include <SFML/Graphics.hpp>
+
+#include "../RectangularBoundaryCollision/RectangularBoundaryCollision.hpp"
+#include "../RectangularBoundaryCollision/AabbTree.hpp"
+#include "../RectangularBoundaryCollision/SweepAndPrune.hpp"
+#include "../RectangularBoundaryCollision/ParallelNarrowPhase.hpp"
+
+
+
+//#define HALVE_WINDOW_SIZE
+
+
+
+int main()
+{
+	sf::Vector2u windowSize{ 1920u, 1080u };
+#ifdef HALVE_WINDOW_SIZE
+	windowSize /= 2u;
+#endif // HALVE_WINDOW_SIZE
+	const sf::Vector2f windowSizeFloat(windowSize);
+
+
+
+	// objects
+	constexpr std::size_t numberOfObjects{ 3000u };
+	constexpr float maximumSpeed{ 100.f }; // pixels per second
+	constexpr float maximumRotationSpeed{ 90.f }; // degrees per second
+	std::vector<sf::RectangleShape> objects(numberOfObjects);
+	std::vector<sf::Vector2f> velocities(numberOfObjects);
+	std::vector<float> rotationSpeeds(numberOfObjects);
+	for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+	{
+		objects[i].setSize({ static_cast<float>(4 + (rand() % 20)), static_cast<float>(4 + (rand() % 20)) });
+		objects[i].setOrigin(objects[i].getSize() / 2.f);
+		objects[i].setPosition({ static_cast<float>(rand() % windowSize.x), static_cast<float>(rand() % windowSize.y) });
+		objects[i].setRotation(sf::degrees((rand() % 1000) * 0.36f));
+		velocities[i] = { ((rand() % 2001) - 1000) * maximumSpeed / 1000.f, ((rand() % 2001) - 1000) * maximumSpeed / 1000.f };
+		rotationSpeeds[i] = ((rand() % 2001) - 1000) * maximumRotationSpeed / 1000.f;
+	}
+	std::vector<bool> isColliding(numberOfObjects);
+
+	// broad phases can also take a range of pointers to objects (e.g. a scene's list of objects that are stored elsewhere)
+	std::vector<sf::RectangleShape*> objectPointers(numberOfObjects);
+	for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+		objectPointers[i] = &objects[i];
+
+
+
+	// broad phases
+	collision::SpatialHash spatialHash(32.f);
+	collision::AabbTree<sf::RectangleShape> aabbTree;
+	std::vector<std::size_t> proxyIds(numberOfObjects);
+	for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+		proxyIds[i] = aabbTree.insert(objects[i]);
+	collision::SweepAndPrune sweepAndPrune;
+	collision::ParallelNarrowPhase parallelNarrowPhase;
+	std::vector<collision::Pair> candidatePairs;
+	std::vector<collision::Pair> collisions;
+
+
+
+	// broad phase method. this can be toggled by pressing SPACE
+	enum class Method
+	{
+		BruteForce,
+		SpatialHash,
+		AabbTree,
+		SweepAndPrune,
+		ParallelNarrowPhase,
+	} method{ Method::BruteForce };
+
+
+
+	sf::Clock clock; // clock for frame time
+	sf::Clock collisionClock; // clock for measuring the time taken to find collisions
+	sf::RenderWindow window(sf::VideoMode(windowSize), "");
+	while (window.isOpen())
+	{
+		const float frameTime{ clock.restart().asSeconds() };
+
+		// move objects (bouncing off the window's edges)
+		for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+		{
+			sf::Vector2f position{ objects[i].getPosition() + (velocities[i] * frameTime) };
+			if (((position.x < 0.f) && (velocities[i].x < 0.f)) || ((position.x > windowSizeFloat.x) && (velocities[i].x > 0.f)))
+				velocities[i].x = -velocities[i].x;
+			if (((position.y < 0.f) && (velocities[i].y < 0.f)) || ((position.y > windowSizeFloat.y) && (velocities[i].y > 0.f)))
+				velocities[i].y = -velocities[i].y;
+			objects[i].setPosition(position);
+			objects[i].rotate(sf::degrees(rotationSpeeds[i] * frameTime));
+		}
+
+		// find colliding pairs
+		collisionClock.restart();
+		switch (method)
+		{
+		case Method::SpatialHash:
+			spatialHash.findCollisions(objectPointers, collisions);
+			break;
+		case Method::AabbTree:
+			for (auto& proxyId : proxyIds)
+				aabbTree.move(proxyId);
+			aabbTree.findCollisions(collisions);
+			for (auto& pair : collisions) // convert proxy IDs to object indices
+				pair = { static_cast<std::size_t>(&aabbTree.getObject(pair.first) - objects.data()), static_cast<std::size_t>(&aabbTree.getObject(pair.second) - objects.data()) };
+			break;
+		case Method::SweepAndPrune:
+			sweepAndPrune.findCollisions(objectPointers, collisions);
+			break;
+		case Method::ParallelNarrowPhase:
+			spatialHash.findCollisions(objects, candidatePairs, 0);
+			parallelNarrowPhase.findCollisions(objectPointers, candidatePairs, collisions);
+			break;
+		case Method::BruteForce:
+		default:
+			collisions.clear();
+			for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+			{
+				for (std::size_t j{ i + 1u }; j < numberOfObjects; ++j)
+				{
+					if (collision::areColliding(objects[i], objects[j]))
+						collisions.push_back({ i, j });
+				}
+			}
+			break;
+		}
+		const sf::Time collisionDuration{ collisionClock.getElapsedTime() };
+
+		// colour objects
+		std::fill(isColliding.begin(), isColliding.end(), false);
+		for (auto& pair : collisions)
+		{
+			isColliding[pair.first] = true;
+			isColliding[pair.second] = true;
+		}
+		for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+			objects[i].setFillColor(isColliding[i] ? sf::Color::Red : sf::Color::Green);
+
+		// render
+		window.clear();
+		for (auto& object : objects)
+			window.draw(object);
+		window.display();
+
+		// show collision time in window title
+		const std::string methodName{ (method == Method::BruteForce) ? "BRUTE FORCE:     " : (method == Method::SpatialHash) ? "SPATIAL HASH:     " : (method == Method::AabbTree) ? "AABB TREE:     " : (method == Method::SweepAndPrune) ? "SWEEP AND PRUNE:     " : "PARALLEL NARROW PHASE:     " };
+		window.setTitle(methodName + std::to_string(collisionDuration.asMicroseconds()) + " microseconds     " + std::to_string(collisions.size()) + " collisions");
+
+		// events
+		while (const auto event{ window.pollEvent() })
+		{
+			if (event->is<sf::Event::Closed>())
+				window.close();
+			else if (const auto keyPressed{ event->getIf<sf::Event::KeyPressed>() })
+			{
+				switch (keyPressed->code)
+				{
+				case sf::Keyboard::Key::Escape:
+					window.close();
+					break;
+				case sf::Keyboard::Key::Space:
+					method = (method == Method::BruteForce) ? Method::SpatialHash : (method == Method::SpatialHash) ? Method::AabbTree : (method == Method::AabbTree) ? Method::SweepAndPrune : (method == Method::SweepAndPrune) ? Method::ParallelNarrowPhase : Method::BruteForce;
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,406 @@
+#ifndef RECTANGULAR_BOUNDARY_COLLISION_PROXY_SET_HPP
+#define RECTANGULAR_BOUNDARY_COLLISION_PROXY_SET_HPP
+
+#include "RectangularBoundaryCollision.hpp"
+
+#if !defined(RECTANGULAR_BOUNDARY_COLLISION_NO_SIMD)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define RECTANGULAR_BOUNDARY_COLLISION_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define RECTANGULAR_BOUNDARY_COLLISION_SIMD_SSE
+#endif
+#endif // RECTANGULAR_BOUNDARY_COLLISION_NO_SIMD
+
+namespace collision
+{
+	namespace impl
+	{
+
+#if defined(RECTANGULAR_BOUNDARY_COLLISION_SIMD_AVX)
+struct Lanes
+{
+	using Type = __m256;
+	static constexpr std::size_t count{ 8u };
+	static Type load(const float* values) { return _mm256_loadu_ps(values); }
+	static Type set(const float value) { return _mm256_set1_ps(value); }
+	static Type add(const Type a, const Type b) { return _mm256_add_ps(a, b); }
+	static Type multiply(const Type a, const Type b) { return _mm256_mul_ps(a, b); }
+	static Type minimum(const Type a, const Type b) { return _mm256_min_ps(a, b); }
+	static Type maximum(const Type a, const Type b) { return _mm256_max_ps(a, b); }
+	static Type isLess(const Type a, const Type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static Type isGreaterOrEqual(const Type a, const Type b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	static Type isNotGreaterOrEqual(const Type a, const Type b) { return _mm256_cmp_ps(a, b, _CMP_NGE_UQ); }
+	static Type isNotLessOrEqual(const Type a, const Type b) { return _mm256_cmp_ps(a, b, _CMP_NLE_UQ); }
+	static Type bitwiseAnd(const Type a, const Type b) { return _mm256_and_ps(a, b); }
+	static Type bitwiseOr(const Type a, const Type b) { return _mm256_or_ps(a, b); }
+	static unsigned int getMask(const Type a) { return static_cast<unsigned int>(_mm256_movemask_ps(a)); }
+};
+#elif defined(RECTANGULAR_BOUNDARY_COLLISION_SIMD_SSE)
+struct Lanes
+{
+	using Type = __m128;
+	static constexpr std::size_t count{ 4u };
+	static Type load(const float* values) { return _mm_loadu_ps(values); }
+	static Type set(const float value) { return _mm_set1_ps(value); }
+	static Type add(const Type a, const Type b) { return _mm_add_ps(a, b); }
+	static Type multiply(const Type a, const Type b) { return _mm_mul_ps(a, b); }
+	static Type minimum(const Type a, const Type b) { return _mm_min_ps(a, b); }
+	static Type maximum(const Type a, const Type b) { return _mm_max_ps(a, b); }
+	static Type isLess(const Type a, const Type b) { return _mm_cmplt_ps(a, b); }
+	static Type isGreaterOrEqual(const Type a, const Type b) { return _mm_cmpge_ps(a, b); }
+	static Type isNotGreaterOrEqual(const Type a, const Type b) { return _mm_cmpnge_ps(a, b); }
+	static Type isNotLessOrEqual(const Type a, const Type b) { return _mm_cmpnle_ps(a, b); }
+	static Type bitwiseAnd(const Type a, const Type b) { return _mm_and_ps(a, b); }
+	static Type bitwiseOr(const Type a, const Type b) { return _mm_or_ps(a, b); }
+	static unsigned int getMask(const Type a) { return static_cast<unsigned int>(_mm_movemask_ps(a)); }
+};
+#endif
+
+	} // namespace impl
+
+// structure-of-arrays store of collision proxies for testing one object against many others at once (e.g. bullets against crowds or selection boxes)
+// each value that the collision tests use (bounding box edges, corners, inverse transform and local bounds) is kept in its own contiguous array
+// testing processes multiple proxies at once using SSE or AVX (if available) and the remainder one at a time
+//     levels 1 and 2 are only calculated for a group of lanes when at least one of their bounding boxes (level 0) intersects
+// results are identical to areColliding (with the proxy first) since the SIMD and scalar calculations are the same, operation for operation
+//     (if your compiler is allowed to contract multiplies and adds into FMA instructions, disable it, e.g. -ffp-contract=off, to keep them identical)
+// define RECTANGULAR_BOUNDARY_COLLISION_NO_SIMD to always use the scalar calculations
+class CollisionProxySet
+{
+public:
+	std::size_t add(const CollisionProxy& proxy)
+	{
+		const std::size_t index{ getSize() };
+		m_boundsLeft.emplace_back();
+		m_boundsTop.emplace_back();
+		m_boundsRight.emplace_back();
+		m_boundsBottom.emplace_back();
+		for (std::size_t corner{ 0u }; corner < 4u; ++corner)
+		{
+			m_cornersX[corner].emplace_back();
+			m_cornersY[corner].emplace_back();
+		}
+		m_inverseXx.emplace_back();
+		m_inverseXy.emplace_back();
+		m_inverseXt.emplace_back();
+		m_inverseYx.emplace_back();
+		m_inverseYy.emplace_back();
+		m_inverseYt.emplace_back();
+		m_localLeft.emplace_back();
+		m_localTop.emplace_back();
+		m_localRight.emplace_back();
+		m_localBottom.emplace_back();
+		m_localWidth.emplace_back();
+		m_localHeight.emplace_back();
+		set(index, proxy);
+		return index;
+	}
+	// object can be any object that can be tested with areColliding
+	template <class T>
+	std::size_t add(const T& object)
+	{
+		return add(CollisionProxy(object));
+	}
+	void set(const std::size_t index, const CollisionProxy& proxy)
+	{
+		m_boundsLeft[index] = proxy.bounds.position.x;
+		m_boundsTop[index] = proxy.bounds.position.y;
+		m_boundsRight[index] = proxy.bounds.position.x + proxy.bounds.size.x;
+		m_boundsBottom[index] = proxy.bounds.position.y + proxy.bounds.size.y;
+		for (std::size_t corner{ 0u }; corner < 4u; ++corner)
+		{
+			m_cornersX[corner][index] = proxy.corners[corner].x;
+			m_cornersY[corner][index] = proxy.corners[corner].y;
+		}
+		const float* const matrix{ proxy.inverseTransform.getMatrix() };
+		m_inverseXx[index] = matrix[0u];
+		m_inverseXy[index] = matrix[4u];
+		m_inverseXt[index] = matrix[12u];
+		m_inverseYx[index] = matrix[1u];
+		m_inverseYy[index] = matrix[5u];
+		m_inverseYt[index] = matrix[13u];
+		const sf::FloatRect& localBounds{ proxy.localBounds };
+		m_localLeft[index] = std::min(localBounds.position.x, localBounds.position.x + localBounds.size.x);
+		m_localTop[index] = std::min(localBounds.position.y, localBounds.position.y + localBounds.size.y);
+		m_localRight[index] = std::max(localBounds.position.x, localBounds.position.x + localBounds.size.x);
+		m_localBottom[index] = std::max(localBounds.position.y, localBounds.position.y + localBounds.size.y);
+		m_localWidth[index] = localBounds.size.x;
+		m_localHeight[index] = localBounds.size.y;
+	}
+	template <class T>
+	void set(const std::size_t index, const T& object)
+	{
+		set(index, CollisionProxy(object));
+	}
+	void clear()
+	{
+		for (auto* values : getAllValues())
+			values->clear();
+	}
+	void reserve(const std::size_t numberOfProxies)
+	{
+		for (auto* values : getAllValues())
+			values->reserve(numberOfProxies);
+	}
+	std::size_t getSize() const
+	{
+		return m_boundsLeft.size();
+	}
+
+	// indices (in ascending order) of the proxies in the set that collide with the proxy
+	// collision level is the same as for areColliding
+	void findCollisions(const CollisionProxy& proxy, std::vector<std::size_t>& indices, const int collisionLevel = -1) const
+	{
+		indices.clear();
+		const Query query{ proxy };
+		std::size_t index{ 0u };
+#if defined(RECTANGULAR_BOUNDARY_COLLISION_SIMD_AVX) || defined(RECTANGULAR_BOUNDARY_COLLISION_SIMD_SSE)
+		using Lanes = impl::Lanes;
+		for (; (index + Lanes::count) <= getSize(); index += Lanes::count)
+		{
+			unsigned int mask{ testLanes<Lanes>(query, index, collisionLevel) };
+			for (std::size_t lane{ 0u }; mask != 0u; ++lane, mask >>= 1u)
+			{
+				if ((mask & 1u) != 0u)
+					indices.push_back(index + lane);
+			}
+		}
+#endif
+		for (; index < getSize(); ++index)
+		{
+			if (test(query, index, collisionLevel))
+				indices.push_back(index);
+		}
+	}
+	// same as findCollisions without SIMD (for verification)
+	void findCollisionsScalar(const CollisionProxy& proxy, std::vector<std::size_t>& indices, const int collisionLevel = -1) const
+	{
+		indices.clear();
+		const Query query{ proxy };
+		for (std::size_t index{ 0u }; index < getSize(); ++index)
+		{
+			if (test(query, index, collisionLevel))
+				indices.push_back(index);
+		}
+	}
+
+private:
+	std::vector<float> m_boundsLeft{};
+	std::vector<float> m_boundsTop{};
+	std::vector<float> m_boundsRight{};
+	std::vector<float> m_boundsBottom{};
+	std::vector<float> m_cornersX[4u]{}; // top-left, top-right, bottom-right, bottom-left
+	std::vector<float> m_cornersY[4u]{};
+	std::vector<float> m_inverseXx{}; // local x = (world x * Xx + world y * Xy) + Xt
+	std::vector<float> m_inverseXy{};
+	std::vector<float> m_inverseXt{};
+	std::vector<float> m_inverseYx{}; // local y = (world x * Yx + world y * Yy) + Yt
+	std::vector<float> m_inverseYy{};
+	std::vector<float> m_inverseYt{};
+	std::vector<float> m_localLeft{}; // local bounds as used for "contains" (level 1)
+	std::vector<float> m_localTop{};
+	std::vector<float> m_localRight{};
+	std::vector<float> m_localBottom{};
+	std::vector<float> m_localWidth{}; // local size as used for SAT (level 2)
+	std::vector<float> m_localHeight{};
+
+	// the proxy being tested against the set (in the same form as the set)
+	struct Query
+	{
+		float boundsLeft;
+		float boundsTop;
+		float boundsRight;
+		float boundsBottom;
+		float cornersX[4u];
+		float cornersY[4u];
+		float inverseXx;
+		float inverseXy;
+		float inverseXt;
+		float inverseYx;
+		float inverseYy;
+		float inverseYt;
+		float localLeft;
+		float localTop;
+		float localRight;
+		float localBottom;
+		float localWidth;
+		float localHeight;
+
+		explicit Query(const CollisionProxy& proxy)
+		{
+			boundsLeft = proxy.bounds.position.x;
+			boundsTop = proxy.bounds.position.y;
+			boundsRight = proxy.bounds.position.x + proxy.bounds.size.x;
+			boundsBottom = proxy.bounds.position.y + proxy.bounds.size.y;
+			for (std::size_t corner{ 0u }; corner < 4u; ++corner)
+			{
+				cornersX[corner] = proxy.corners[corner].x;
+				cornersY[corner] = proxy.corners[corner].y;
+			}
+			const float* const matrix{ proxy.inverseTransform.getMatrix() };
+			inverseXx = matrix[0u];
+			inverseXy = matrix[4u];
+			inverseXt = matrix[12u];
+			inverseYx = matrix[1u];
+			inverseYy = matrix[5u];
+			inverseYt = matrix[13u];
+			const sf::FloatRect& localBounds{ proxy.localBounds };
+			localLeft = std::min(localBounds.position.x, localBounds.position.x + localBounds.size.x);
+			localTop = std::min(localBounds.position.y, localBounds.position.y + localBounds.size.y);
+			localRight = std::max(localBounds.position.x, localBounds.position.x + localBounds.size.x);
+			localBottom = std::max(localBounds.position.y, localBounds.position.y + localBounds.size.y);
+			localWidth = localBounds.size.x;
+			localHeight = localBounds.size.y;
+		}
+	};
+
+	std::array<std::vector<float>*, 24u> getAllValues()
+	{
+		return { &m_boundsLeft, &m_boundsTop, &m_boundsRight, &m_boundsBottom,
+			&m_cornersX[0u], &m_cornersX[1u], &m_cornersX[2u], &m_cornersX[3u], &m_cornersY[0u], &m_cornersY[1u], &m_cornersY[2u], &m_cornersY[3u],
+			&m_inverseXx, &m_inverseXy, &m_inverseXt, &m_inverseYx, &m_inverseYy, &m_inverseYt,
+			&m_localLeft, &m_localTop, &m_localRight, &m_localBottom, &m_localWidth, &m_localHeight };
+	}
+
+	// same calculations as areColliding(query, proxy at index)
+	bool test(const Query& query, const std::size_t index, const int collisionLevel) const
+	{
+		// LEVEL 0 (axis-aligned bounding box)
+		const bool level0{ (std::max(query.boundsLeft, m_boundsLeft[index]) < std::min(query.boundsRight, m_boundsRight[index])) &&
+			(std::max(query.boundsTop, m_boundsTop[index]) < std::min(query.boundsBottom, m_boundsBottom[index])) };
+		if (!level0 || collisionLevel == 0)
+			return level0;
+
+		// LEVEL 1 (any corners inside opposite rectangle)
+		float queryCornersX[4u]; // query's corners in the other's local coordinates
+		float queryCornersY[4u];
+		float otherCornersX[4u]; // other's corners in the query's local coordinates
+		float otherCornersY[4u];
+		bool level1{ false };
+		for (std::size_t corner{ 0u }; corner < 4u; ++corner)
+		{
+			queryCornersX[corner] = ((m_inverseXx[index] * query.cornersX[corner]) + (m_inverseXy[index] * query.cornersY[corner])) + m_inverseXt[index];
+			queryCornersY[corner] = ((m_inverseYx[index] * query.cornersX[corner]) + (m_inverseYy[index] * query.cornersY[corner])) + m_inverseYt[index];
+			otherCornersX[corner] = ((query.inverseXx * m_cornersX[corner][index]) + (query.inverseXy * m_cornersY[corner][index])) + query.inverseXt;
+			otherCornersY[corner] = ((query.inverseYx * m_cornersX[corner][index]) + (query.inverseYy * m_cornersY[corner][index])) + query.inverseYt;
+			if (((otherCornersX[corner] >= query.localLeft) && (otherCornersX[corner] < query.localRight) && (otherCornersY[corner] >= query.localTop) && (otherCornersY[corner] < query.localBottom)) ||
+				((queryCornersX[corner] >= m_localLeft[index]) && (queryCornersX[corner] < m_localRight[index]) && (queryCornersY[corner] >= m_localTop[index]) && (queryCornersY[corner] < m_localBottom[index])))
+				level1 = true;
+		}
+		if (level1 || collisionLevel == 1)
+			return level1;
+
+		// LEVEL 2 (SAT)
+		const auto sat = [](const float* pointsX, const float* pointsY, const float width, const float height)
+		{
+			bool allPointsLeftOfRectangle{ true };
+			bool allPointsRightOfRectangle{ true };
+			bool allPointsAboveRectangle{ true };
+			bool allPointsBelowRectangle{ true };
+			for (std::size_t corner{ 0u }; corner < 4u; ++corner)
+			{
+				if (pointsX[corner] >= 0.f)
+					allPointsLeftOfRectangle = false;
+				if (pointsX[corner] <= width)
+					allPointsRightOfRectangle = false;
+				if (pointsY[corner] >= 0.f)
+					allPointsAboveRectangle = false;
+				if (pointsY[corner] <= height)
+					allPointsBelowRectangle = false;
+			}
+			return !(allPointsLeftOfRectangle || allPointsRightOfRectangle || allPointsAboveRectangle || allPointsBelowRectangle);
+		};
+		return sat(queryCornersX, queryCornersY, m_localWidth[index], m_localHeight[index]) && sat(otherCornersX, otherCornersY, query.localWidth, query.localHeight);
+	}
+
+#if defined(RECTANGULAR_BOUNDARY_COLLISION_SIMD_AVX) || defined(RECTANGULAR_BOUNDARY_COLLISION_SIMD_SSE)
+	// tests (Lanes::count) proxies, starting at begin, at once and returns a bit mask of the results (bit n is the proxy at begin + n)
+	template <class Lanes>
+	unsigned int testLanes(const Query& query, const std::size_t begin, const int collisionLevel) const
+	{
+		using Type = typename Lanes::Type;
+
+		// LEVEL 0 (axis-aligned bounding box)
+		const Type level0{ Lanes::bitwiseAnd(
+			Lanes::isLess(Lanes::maximum(Lanes::set(query.boundsLeft), Lanes::load(m_boundsLeft.data() + begin)), Lanes::minimum(Lanes::set(query.boundsRight), Lanes::load(m_boundsRight.data() + begin))),
+			Lanes::isLess(Lanes::maximum(Lanes::set(query.boundsTop), Lanes::load(m_boundsTop.data() + begin)), Lanes::minimum(Lanes::set(query.boundsBottom), Lanes::load(m_boundsBottom.data() + begin)))) };
+		const unsigned int level0Mask{ Lanes::getMask(level0) };
+		if ((level0Mask == 0u) || (collisionLevel == 0))
+			return level0Mask;
+
+		// LEVEL 1 (any corners inside opposite rectangle)
+		const Type inverseXx{ Lanes::load(m_inverseXx.data() + begin) };
+		const Type inverseXy{ Lanes::load(m_inverseXy.data() + begin) };
+		const Type inverseXt{ Lanes::load(m_inverseXt.data() + begin) };
+		const Type inverseYx{ Lanes::load(m_inverseYx.data() + begin) };
+		const Type inverseYy{ Lanes::load(m_inverseYy.data() + begin) };
+		const Type inverseYt{ Lanes::load(m_inverseYt.data() + begin) };
+		const Type localLeft{ Lanes::load(m_localLeft.data() + begin) };
+		const Type localTop{ Lanes::load(m_localTop.data() + begin) };
+		const Type localRight{ Lanes::load(m_localRight.data() + begin) };
+		const Type localBottom{ Lanes::load(m_localBottom.data() + begin) };
+		const Type queryInverseXx{ Lanes::set(query.inverseXx) };
+		const Type queryInverseXy{ Lanes::set(query.inverseXy) };
+		const Type queryInverseXt{ Lanes::set(query.inverseXt) };
+		const Type queryInverseYx{ Lanes::set(query.inverseYx) };
+		const Type queryInverseYy{ Lanes::set(query.inverseYy) };
+		const Type queryInverseYt{ Lanes::set(query.inverseYt) };
+		const Type queryLocalLeft{ Lanes::set(query.localLeft) };
+		const Type queryLocalTop{ Lanes::set(query.localTop) };
+		const Type queryLocalRight{ Lanes::set(query.localRight) };
+		const Type queryLocalBottom{ Lanes::set(query.localBottom) };
+		Type queryCornersX[4u]; // query's corners in each other's local coordinates
+		Type queryCornersY[4u];
+		Type otherCornersX[4u]; // others' corners in the query's local coordinates
+		Type otherCornersY[4u];
+		Type level1{ Lanes::set(0.f) };
+		for (std::size_t corner{ 0u }; corner < 4u; ++corner)
+		{
+			const Type queryCornerX{ Lanes::set(query.cornersX[corner]) };
+			const Type queryCornerY{ Lanes::set(query.cornersY[corner]) };
+			const Type otherCornerX{ Lanes::load(m_cornersX[corner].data() + begin) };
+			const Type otherCornerY{ Lanes::load(m_cornersY[corner].data() + begin) };
+			queryCornersX[corner] = Lanes::add(Lanes::add(Lanes::multiply(inverseXx, queryCornerX), Lanes::multiply(inverseXy, queryCornerY)), inverseXt);
+			queryCornersY[corner] = Lanes::add(Lanes::add(Lanes::multiply(inverseYx, queryCornerX), Lanes::multiply(inverseYy, queryCornerY)), inverseYt);
+			otherCornersX[corner] = Lanes::add(Lanes::add(Lanes::multiply(queryInverseXx, otherCornerX), Lanes::multiply(queryInverseXy, otherCornerY)), queryInverseXt);
+			otherCornersY[corner] = Lanes::add(Lanes::add(Lanes::multiply(queryInverseYx, otherCornerX), Lanes::multiply(queryInverseYy, otherCornerY)), queryInverseYt);
+			const Type isOtherCornerInside{ Lanes::bitwiseAnd(
+				Lanes::bitwiseAnd(Lanes::isGreaterOrEqual(otherCornersX[corner], queryLocalLeft), Lanes::isLess(otherCornersX[corner], queryLocalRight)),
+				Lanes::bitwiseAnd(Lanes::isGreaterOrEqual(otherCornersY[corner], queryLocalTop), Lanes::isLess(otherCornersY[corner], queryLocalBottom))) };
+			const Type isQueryCornerInside{ Lanes::bitwiseAnd(
+				Lanes::bitwiseAnd(Lanes::isGreaterOrEqual(queryCornersX[corner], localLeft), Lanes::isLess(queryCornersX[corner], localRight)),
+				Lanes::bitwiseAnd(Lanes::isGreaterOrEqual(queryCornersY[corner], localTop), Lanes::isLess(queryCornersY[corner], localBottom))) };
+			level1 = Lanes::bitwiseOr(level1, Lanes::bitwiseOr(isOtherCornerInside, isQueryCornerInside));
+		}
+		const unsigned int level1Mask{ level0Mask & Lanes::getMask(level1) };
+		if ((level1Mask == level0Mask) || (collisionLevel == 1))
+			return level1Mask;
+
+		// LEVEL 2 (SAT)
+		const auto sat = [](const Type* pointsX, const Type* pointsY, const Type width, const Type height)
+		{
+			const Type zero{ Lanes::set(0.f) };
+			Type allPointsLeftOfRectangle{ Lanes::isNotGreaterOrEqual(pointsX[0u], zero) };
+			Type allPointsRightOfRectangle{ Lanes::isNotLessOrEqual(pointsX[0u], width) };
+			Type allPointsAboveRectangle{ Lanes::isNotGreaterOrEqual(pointsY[0u], zero) };
+			Type allPointsBelowRectangle{ Lanes::isNotLessOrEqual(pointsY[0u], height) };
+			for (std::size_t corner{ 1u }; corner < 4u; ++corner)
+			{
+				allPointsLeftOfRectangle = Lanes::bitwiseAnd(allPointsLeftOfRectangle, Lanes::isNotGreaterOrEqual(pointsX[corner], zero));
+				allPointsRightOfRectangle = Lanes::bitwiseAnd(allPointsRightOfRectangle, Lanes::isNotLessOrEqual(pointsX[corner], width));
+				allPointsAboveRectangle = Lanes::bitwiseAnd(allPointsAboveRectangle, Lanes::isNotGreaterOrEqual(pointsY[corner], zero));
+				allPointsBelowRectangle = Lanes::bitwiseAnd(allPointsBelowRectangle, Lanes::isNotLessOrEqual(pointsY[corner], height));
+			}
+			return ~Lanes::getMask(Lanes::bitwiseOr(Lanes::bitwiseOr(allPointsLeftOfRectangle, allPointsRightOfRectangle), Lanes::bitwiseOr(allPointsAboveRectangle, allPointsBelowRectangle)));
+		};
+		const unsigned int level2Mask{ sat(queryCornersX, queryCornersY, Lanes::load(m_localWidth.data() + begin), Lanes::load(m_localHeight.data() + begin)) &
+			sat(otherCornersX, otherCornersY, Lanes::set(query.localWidth), Lanes::set(query.localHeight)) };
+		return level1Mask | (level0Mask & level2Mask);
+	}
+#endif
+};
+
+} // namespace collision
+#endif // RECTANGULAR_BOUNDARY_COLLISION_PROXY_SET_HPP
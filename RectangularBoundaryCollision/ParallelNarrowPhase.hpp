@@ -0,0 +1,125 @@
+#ifndef RECTANGULAR_BOUNDARY_COLLISION_PARALLEL_NARROW_PHASE_HPP
+#define RECTANGULAR_BOUNDARY_COLLISION_PARALLEL_NARROW_PHASE_HPP
+
+#include "RectangularBoundaryCollision.hpp"
+#include "../WorkerPool/WorkerPool.hpp"
+
+#include <memory>
+
+namespace collision
+{
+
+// narrow phase that tests many candidate pairs (e.g. the pairs found by a broad phase at level 0) across multiple threads
+// a proxy is first stored for every object (each object is read by only one thread) and the pairs are then tested using these proxies
+//     the pairs are split into fixed-size chunks that are shared out between the threads as each thread finishes its previous chunk
+//     each chunk has its own buffer of colliding pairs so the result does not depend on which thread tested which chunk
+// the buffers are joined (in order) and sorted so the output is the same for any number of threads
+// objects can be any random-access range of objects (or of pointers to objects) that can be tested with areColliding
+class ParallelNarrowPhase
+{
+public:
+	// 1 tests all pairs on the calling thread
+	// 0 (default) uses as many threads as the hardware supports
+	// the calling thread is always one of the threads used
+	explicit ParallelNarrowPhase(const std::size_t numberOfThreads = 0u)
+	{
+		setNumberOfThreads(numberOfThreads);
+	}
+	void setNumberOfThreads(std::size_t numberOfThreads)
+	{
+		if (numberOfThreads == 0u)
+			numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		if (numberOfThreads == getNumberOfThreads())
+			return;
+		m_workerPool.reset();
+		if (numberOfThreads > 1u)
+			m_workerPool = std::make_unique<workerPool::WorkerPool>(numberOfThreads - 1u);
+	}
+	std::size_t getNumberOfThreads() const
+	{
+		return (m_workerPool) ? m_workerPool->getNumberOfThreads() : 1u;
+	}
+	// number of pairs tested by each task
+	void setChunkSize(const std::size_t chunkSize)
+	{
+		m_chunkSize = std::max(chunkSize, std::size_t{ 1u });
+	}
+	std::size_t getChunkSize() const
+	{
+		return m_chunkSize;
+	}
+	// candidates are pairs of indices into objects (in either order)
+	// collisions are the candidates that collide with their indices swapped, if needed, so that first is less than second, sorted by first and then by second
+	// collision level is the same as for areColliding
+	// no allocations are made once storage has grown to fit the objects and pairs
+	template <class ObjectRange>
+	void findCollisions(const ObjectRange& objects, const Pair* const candidates, const std::size_t numberOfCandidates, std::vector<Pair>& collisions, const int collisionLevel = -1)
+	{
+		collisions.clear();
+		const std::size_t numberOfObjects{ static_cast<std::size_t>(std::size(objects)) };
+		m_proxies.resize(numberOfObjects);
+
+		auto updateProxies = [&](const std::size_t taskIndex)
+		{
+			const std::size_t end{ std::min((taskIndex + 1u) * m_chunkSize, numberOfObjects) };
+			for (std::size_t i{ taskIndex * m_chunkSize }; i < end; ++i)
+				m_proxies[i].update(impl::getObject(objects[i]));
+		};
+		run(getNumberOfChunks(numberOfObjects), updateProxies);
+
+		const std::size_t numberOfChunks{ getNumberOfChunks(numberOfCandidates) };
+		if (m_chunkCollisions.size() < numberOfChunks)
+			m_chunkCollisions.resize(numberOfChunks);
+		auto testPairs = [&](const std::size_t taskIndex)
+		{
+			std::vector<Pair>& chunkCollisions{ m_chunkCollisions[taskIndex] };
+			chunkCollisions.clear();
+			const std::size_t end{ std::min((taskIndex + 1u) * m_chunkSize, numberOfCandidates) };
+			for (std::size_t c{ taskIndex * m_chunkSize }; c < end; ++c)
+			{
+				const Pair& candidate{ candidates[c] };
+				if (areColliding(m_proxies[candidate.first], m_proxies[candidate.second], collisionLevel))
+					chunkCollisions.push_back((candidate.first < candidate.second) ? candidate : Pair{ candidate.second, candidate.first });
+			}
+		};
+		run(numberOfChunks, testPairs);
+
+		std::size_t numberOfCollisions{ 0u };
+		for (std::size_t chunk{ 0u }; chunk < numberOfChunks; ++chunk)
+			numberOfCollisions += m_chunkCollisions[chunk].size();
+		collisions.reserve(numberOfCollisions);
+		for (std::size_t chunk{ 0u }; chunk < numberOfChunks; ++chunk)
+			collisions.insert(collisions.end(), m_chunkCollisions[chunk].begin(), m_chunkCollisions[chunk].end());
+		std::sort(collisions.begin(), collisions.end(), [](const Pair& a, const Pair& b) { return (a.first < b.first) || ((a.first == b.first) && (a.second < b.second)); });
+	}
+	template <class ObjectRange>
+	void findCollisions(const ObjectRange& objects, const std::vector<Pair>& candidates, std::vector<Pair>& collisions, const int collisionLevel = -1)
+	{
+		findCollisions(objects, candidates.data(), candidates.size(), collisions, collisionLevel);
+	}
+
+private:
+	std::unique_ptr<workerPool::WorkerPool> m_workerPool{};
+	std::size_t m_chunkSize{ 1024u };
+	std::vector<CollisionProxy> m_proxies{};
+	std::vector<std::vector<Pair>> m_chunkCollisions{};
+
+	std::size_t getNumberOfChunks(const std::size_t numberOfItems) const
+	{
+		return (numberOfItems + m_chunkSize - 1u) / m_chunkSize;
+	}
+	template <class Task>
+	void run(const std::size_t numberOfTasks, Task& task)
+	{
+		if (m_workerPool && (numberOfTasks > 1u))
+			m_workerPool->run(numberOfTasks, task);
+		else
+		{
+			for (std::size_t taskIndex{ 0u }; taskIndex < numberOfTasks; ++taskIndex)
+				task(taskIndex);
+		}
+	}
+};
+
+} // namespace collision
+#endif // RECTANGULAR_BOUNDARY_COLLISION_PARALLEL_NARROW_PHASE_HPP
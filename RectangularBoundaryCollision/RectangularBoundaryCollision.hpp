@@ -2,14 +2,84 @@
 #define RECTANGULAR_BOUNDARY_COLLISION_HPP
 
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace collision
 {
+
+struct CollisionProxy;
+struct Contact;
+
 	namespace impl
 	{
 
-bool satRectangleAndPoints(const sf::Vector2f rectangleSize, const std::array<sf::Vector2f, 4>& points);
+inline bool satRectangleAndPoints(const sf::Vector2f rectangleSize, const std::array<sf::Vector2f, 4>& points);
+
+// levels 1 and 2 of areColliding (level 0 must already have found an intersection)
+template <class T1, class T2>
+bool areCollidingBeyondLevel0(const T1& object1, const sf::Transform& transform1, const T2& object2, const sf::Transform& transform2, const int collisionLevel);
+inline bool areCollidingBeyondLevel0(const CollisionProxy& proxy1, const CollisionProxy& proxy2, const int collisionLevel);
+template <int collisionLevel>
+bool areCollidingBeyondLevel0(const CollisionProxy& proxy1, const CollisionProxy& proxy2);
+
+// neither rotated nor skewed (flips and scales are fine) so the transformed rectangle is its own bounding box
+inline bool isAxisAligned(const sf::Transform& transform);
+
+// bounding box of an object that is axis-aligned, found from only two of its corners (the same as the bounding box found from all four)
+template <class T>
+sf::FloatRect getAxisAlignedBounds(const T& object);
+
+// tests the other's corners against the rectangle's axes, updating the contact if an axis has less overlap than the contact's current depth
+inline void findShallowestAxis(const CollisionProxy& rectangle, const CollisionProxy& other, bool isRectangleFirst, Contact& contact, bool& hasAxis);
+
+// earliest time (from 0 to 1) that the two sets of corners touch while the second set moves by displacement (relative to the first)
+// the separating axes are the normals of both sets' edges (or, for zero-size sets, the remaining edge and the axes themselves)
+inline bool findTimeOfImpactOfCorners(const std::array<sf::Vector2f, 4>& corners1, const std::array<sf::Vector2f, 4>& corners2, sf::Vector2f displacement, float& time);
+
+// as above but each set of corners also rotates (by rotation in radians over the step) around its pivot
+// found by conservative advancement (the time is never after they first touch)
+inline bool findTimeOfImpactOfRotatingCorners(const std::array<sf::Vector2f, 4>& corners1, sf::Vector2f pivot1, sf::Vector2f displacement1, float rotation1, const std::array<sf::Vector2f, 4>& corners2, sf::Vector2f pivot2, sf::Vector2f displacement2, float rotation2, float tolerance, float& time);
+
+// shortest distance between two sets of corners that are not touching
+// normal is the direction (of unit length) from the first set's closest point to the second set's closest point
+inline float findDistanceBetweenCorners(const std::array<sf::Vector2f, 4>& corners1, const std::array<sf::Vector2f, 4>& corners2, sf::Vector2f& normal);
+
+// stores everything in the proxy except for its bounding box
+template <class T>
+void updateProxyCorners(CollisionProxy& proxy, const T& object, const sf::Transform& transform);
+
+// allows ranges of objects and ranges of pointers to objects to be used in the same way
+template <class T>
+const std::remove_pointer_t<std::remove_cv_t<T>>& getObject(const T& object);
+
+// cell coordinate (of a spatial hash) that contains the value (clamped so that huge values cannot overflow)
+inline int getCellCoordinate(float value, float cellSize);
+inline std::uint64_t getCellKey(int x, int y);
+
+// same as level 0 of areColliding (bounding boxes that only touch do not intersect)
+inline bool areBoundsIntersecting(const sf::FloatRect& bounds1, const sf::FloatRect& bounds2);
+
+// tests the line segment from start to end against the (axis-aligned) rectangle, which includes its edges
+// fraction is how far along the segment the first hit is and only hits at or before maximumFraction are counted
+inline bool rayHitsRectangle(const sf::FloatRect& rectangle, sf::Vector2f start, sf::Vector2f end, float& fraction, float maximumFraction = 1.f);
+inline bool rayHitsRectangle(sf::Vector2f topLeft, sf::Vector2f bottomRight, sf::Vector2f start, sf::Vector2f end, float& fraction, float maximumFraction = 1.f);
+
+// an axis-aligned rectangle that can be tested like an object (e.g. with areColliding)
+struct RectangleObject
+{
+	sf::FloatRect rectangle;
+
+	sf::Transform getTransform() const;
+	sf::Transform getInverseTransform() const;
+	sf::FloatRect getLocalBounds() const;
+};
 
 	} // namespace impl
 
@@ -35,19 +105,440 @@ bool areColliding(const T1& object1, const T2& object2, const int collisionLevel
 	if (!level0 || collisionLevel == 0)
 		return level0;
 
+	return impl::areCollidingBeyondLevel0(object1, transform1, object2, transform2, collisionLevel);
+}
+
+// snapshot of everything about an object that the collision tests need
+// taking this once per object (e.g. once per frame) means that testing an object against many others only does the work for each pair
+// stores the object's corners and bounding box (level 0) in world coordinates as well as its axes and its projections on them:
+//     the rows of the inverse transform are the object's axes (along its edges) so transforming a world point with it projects that point onto both axes at once
+//     the object's own projections on these axes are its local bounds
+// must be updated whenever the object changes
+struct CollisionProxy
+{
+	std::array<sf::Vector2f, 4> corners{}; // top-left, top-right, bottom-right, bottom-left
+	sf::FloatRect bounds{};
+	sf::Transform inverseTransform{};
+	sf::FloatRect localBounds{};
+
+	CollisionProxy() = default;
+	template <class T>
+	explicit CollisionProxy(const T& object)
+	{
+		update(object);
+	}
+	// object can be any object that can be tested with areColliding
+	template <class T>
+	void update(const T& object)
+	{
+		const sf::Transform transform{ object.getTransform() };
+		impl::updateProxyCorners(*this, object, transform);
+		bounds = transform.transformRect(localBounds);
+	}
+};
+
+// same as areColliding for objects (with the same results) but uses the objects' proxies
+inline bool areColliding(const CollisionProxy& proxy1, const CollisionProxy& proxy2, const int collisionLevel = -1)
+{
+	// LEVEL 0 (axis-aligned bounding box)
+	const bool level0{ impl::areBoundsIntersecting(proxy1.bounds, proxy2.bounds) };
+	if (!level0 || collisionLevel == 0)
+		return level0;
+
+	return impl::areCollidingBeyondLevel0(proxy1, proxy2, collisionLevel);
+}
+
+// the same as areColliding but the collision level is chosen at compile time so only the levels that are used are compiled
+// at level 2 (or maximum), objects that are both axis-aligned (neither rotated nor skewed) are detected after level 0 and not tested further since level 0 is exact for them
+//     this skips their inverse transforms and corners entirely
+//     the result can only differ from areColliding when edges are within rounding of touching; level 0 is the more precise
+// level 1 is never skipped so its results are always the same as areColliding at level 1
+// objects that are known to always be axis-aligned (e.g. tiles and UI) can declare it by using areCollidingAxisAligned instead
+// can test any two objects that can be tested with areColliding
+template <int collisionLevel = -1, class T1, class T2>
+bool areCollidingAtLevel(const T1& object1, const T2& object2)
+{
+	static_assert(collisionLevel <= 2, "collision level must be 0, 1, 2 or negative (maximum)");
+
+	// LEVEL 0 (axis-aligned bounding box)
+	const sf::Transform transform1{ object1.getTransform() };
+	const sf::Transform transform2{ object2.getTransform() };
+	const bool level0{ transform1.transformRect(object1.getLocalBounds()).findIntersection(transform2.transformRect(object2.getLocalBounds())) };
+	if constexpr (collisionLevel == 0)
+		return level0;
+	else
+	{
+		if (!level0)
+			return false;
+		if constexpr (collisionLevel != 1)
+		{
+			if (impl::isAxisAligned(transform1) && impl::isAxisAligned(transform2))
+				return true;
+		}
+
+		CollisionProxy proxy1;
+		CollisionProxy proxy2;
+		impl::updateProxyCorners(proxy1, object1, transform1);
+		impl::updateProxyCorners(proxy2, object2, transform2);
+		return impl::areCollidingBeyondLevel0<(collisionLevel == 1) ? 1 : -1>(proxy1, proxy2);
+	}
+}
+// the same as above but uses the objects' proxies (axis-aligned objects are detected from their inverse transforms)
+template <int collisionLevel = -1>
+bool areCollidingAtLevel(const CollisionProxy& proxy1, const CollisionProxy& proxy2)
+{
+	static_assert(collisionLevel <= 2, "collision level must be 0, 1, 2 or negative (maximum)");
+
+	// LEVEL 0 (axis-aligned bounding box)
+	const bool level0{ impl::areBoundsIntersecting(proxy1.bounds, proxy2.bounds) };
+	if constexpr (collisionLevel == 0)
+		return level0;
+	else
+	{
+		if (!level0)
+			return false;
+		if constexpr (collisionLevel != 1)
+		{
+			if (impl::isAxisAligned(proxy1.inverseTransform) && impl::isAxisAligned(proxy2.inverseTransform))
+				return true;
+		}
+
+		return impl::areCollidingBeyondLevel0<(collisionLevel == 1) ? 1 : -1>(proxy1, proxy2);
+	}
+}
+
+// returns a boolean representing if the two objects' rectangular boundaries are colliding when both objects are declared to be axis-aligned (neither rotated nor skewed; flips and scales are fine)
+// their bounding boxes are then the rectangles themselves so only their bounding boxes are tested, each found from two transformed corners
+//     nothing else is calculated: no inverse transforms, no further corners and no check that the objects are axis-aligned
+// the result is the same as areCollidingAtLevel (at level 2 or maximum) for objects that are axis-aligned; it is meaningless for objects that are not
+// can test any two objects that can be tested with areColliding
+template <class T1, class T2>
+bool areCollidingAxisAligned(const T1& object1, const T2& object2)
+{
+	return impl::areBoundsIntersecting(impl::getAxisAlignedBounds(object1), impl::getAxisAlignedBounds(object2));
+}
+inline bool areCollidingAxisAligned(const CollisionProxy& proxy1, const CollisionProxy& proxy2)
+{
+	return impl::areBoundsIntersecting(proxy1.bounds, proxy2.bounds);
+}
+
+// how two colliding objects overlap
+// normal is the direction (of unit length) from the first object towards the second along which they overlap the least
+// depth is how far they overlap along normal
+// translation is the minimum translation vector: moving the first object by this (or the second object by its negative) separates them, leaving them touching
+// point is the corner that is deepest inside the other object
+struct Contact
+{
+	sf::Vector2f normal;
+	float depth;
+	sf::Vector2f translation;
+	sf::Vector2f point;
+};
+
+// returns a boolean representing if the two objects' rectangular boundaries are colliding (the same as areColliding at maximum level)
+// if they are, contact is set to how they overlap so that they can be separated in a single step
+// the overlaps are found along the same axes as the SAT (level 2): both edges of both rectangles
+// can test any two objects that can be tested with areColliding
+inline bool findContact(const CollisionProxy& proxy1, const CollisionProxy& proxy2, Contact& contact)
+{
+	if (!areColliding(proxy1, proxy2))
+		return false;
+
+	bool hasAxis{ false };
+	contact = { { 0.f, 0.f }, 0.f, { 0.f, 0.f }, proxy1.corners[0u] };
+	impl::findShallowestAxis(proxy1, proxy2, true, contact, hasAxis);
+	impl::findShallowestAxis(proxy2, proxy1, false, contact, hasAxis);
+	contact.depth = std::max(contact.depth, 0.f); // objects that are only just colliding can have (tiny) negative overlaps due to rounding
+	contact.translation = -contact.normal * contact.depth;
+	return true;
+}
+template <class T1, class T2>
+bool findContact(const T1& object1, const T2& object2, Contact& contact)
+{
+	return findContact(CollisionProxy(object1), CollisionProxy(object2), contact);
+}
+
+// returns a boolean representing if the ray (a line segment from start to end) hits the object's rectangular boundary
+// if it does, fraction is set to how far along the ray the first hit is (0 at start, 1 at end); it is 0 if start is inside the object
+// can test any object that can be tested with areColliding
+template <class T>
+bool isHitByRay(const T& object, const sf::Vector2f start, const sf::Vector2f end, float& fraction)
+{
+	const sf::Transform inverseTransform{ object.getInverseTransform() };
+	return impl::rayHitsRectangle(object.getLocalBounds(), inverseTransform.transformPoint(start), inverseTransform.transformPoint(end), fraction);
+}
+inline bool isHitByRay(const CollisionProxy& proxy, const sf::Vector2f start, const sf::Vector2f end, float& fraction)
+{
+	// the bounding box rejects most rays without transforming them
+	if (!impl::rayHitsRectangle(proxy.bounds, start, end, fraction))
+		return false;
+	return impl::rayHitsRectangle(proxy.localBounds, proxy.inverseTransform.transformPoint(start), proxy.inverseTransform.transformPoint(end), fraction);
+}
+
+// returns a boolean representing if the point is inside the object's rectangular boundary (including its edges)
+// can test any object that can be tested with areColliding
+template <class T>
+bool isContainingPoint(const T& object, const sf::Vector2f point)
+{
+	const sf::Vector2f localPoint{ object.getInverseTransform().transformPoint(point) };
+	const sf::FloatRect localBounds{ object.getLocalBounds() };
+	return (localPoint.x >= 0.f) && (localPoint.x <= localBounds.size.x) && (localPoint.y >= 0.f) && (localPoint.y <= localBounds.size.y);
+}
+inline bool isContainingPoint(const CollisionProxy& proxy, const sf::Vector2f point)
+{
+	// the bounding box rejects most points without transforming them
+	if ((point.x < proxy.bounds.position.x) || (point.x > (proxy.bounds.position.x + proxy.bounds.size.x)) ||
+		(point.y < proxy.bounds.position.y) || (point.y > (proxy.bounds.position.y + proxy.bounds.size.y)))
+		return false;
+	const sf::Vector2f localPoint{ proxy.inverseTransform.transformPoint(point) };
+	return (localPoint.x >= 0.f) && (localPoint.x <= proxy.localBounds.size.x) && (localPoint.y >= 0.f) && (localPoint.y <= proxy.localBounds.size.y);
+}
+
+// returns a boolean representing if the two objects' rectangular boundaries collide at any time while they move (in a straight line) by their displacements
+// displacements are how far each object moves over the step (from time 0 to time 1)
+// if they do, time is set to the earliest time that they touch (0 if they are already colliding at the start)
+// the time is exact since the separating axes (the same axes as the SAT) do not change while the objects are only moved
+// can test any two objects that can be tested with areColliding
+template <class T1, class T2>
+bool findTimeOfImpact(const T1& object1, const sf::Vector2f displacement1, const T2& object2, const sf::Vector2f displacement2, float& time)
+{
+	const sf::Transform transform1{ object1.getTransform() };
+	const sf::Transform transform2{ object2.getTransform() };
+	CollisionProxy proxy1;
+	CollisionProxy proxy2;
+	impl::updateProxyCorners(proxy1, object1, transform1);
+	impl::updateProxyCorners(proxy2, object2, transform2);
+	return impl::findTimeOfImpactOfCorners(proxy1.corners, proxy2.corners, displacement2 - displacement1, time);
+}
+inline bool findTimeOfImpact(const CollisionProxy& proxy1, const sf::Vector2f displacement1, const CollisionProxy& proxy2, const sf::Vector2f displacement2, float& time)
+{
+	return impl::findTimeOfImpactOfCorners(proxy1.corners, proxy2.corners, displacement2 - displacement1, time);
+}
+
+// the same as above but each object also rotates at a constant rate (by its rotation over the step) around its position (as sf::Transformable does)
+// the time is conservative: it is never after the objects first touch but can be before it
+//     the objects are advanced in steps that are never large enough for any point of one to reach the other
+//     they are considered to have hit once they are within tolerance (in world units) of each other
+//     the earliest time that the advancement did not finish is used if it takes too many steps
+// objects must also have getPosition (e.g. sf::Transformable)
+template <class T1, class T2>
+bool findTimeOfImpact(const T1& object1, const sf::Vector2f displacement1, const sf::Angle rotation1, const T2& object2, const sf::Vector2f displacement2, const sf::Angle rotation2, float& time, const float tolerance = 0.05f)
+{
+	const sf::Transform transform1{ object1.getTransform() };
+	const sf::Transform transform2{ object2.getTransform() };
+	CollisionProxy proxy1;
+	CollisionProxy proxy2;
+	impl::updateProxyCorners(proxy1, object1, transform1);
+	impl::updateProxyCorners(proxy2, object2, transform2);
+	if ((rotation1 == sf::Angle::Zero) && (rotation2 == sf::Angle::Zero))
+		return impl::findTimeOfImpactOfCorners(proxy1.corners, proxy2.corners, displacement2 - displacement1, time);
+	return impl::findTimeOfImpactOfRotatingCorners(proxy1.corners, object1.getPosition(), displacement1, rotation1.asRadians(), proxy2.corners, object2.getPosition(), displacement2, rotation2.asRadians(), tolerance, time);
+}
+
+// indices of two colliding objects (first is always less than second)
+struct Pair
+{
+	std::size_t first;
+	std::size_t second;
+};
+
+// first object hit by a ray
+// point is where the ray first hits it and fraction is how far along the ray that is (0 at start, 1 at end)
+struct RayHit
+{
+	std::size_t index;
+	float fraction;
+	sf::Vector2f point;
+};
+
+// picking queries over many objects
+// these test every object in turn so are the reference for the same queries in AabbTree (which only tests the objects near the query)
+// objects can be any random-access range of objects (or of pointers to objects) that can be tested with areColliding, including a range of proxies
+//     proxies are faster to test when the same objects are queried more than once without changing
+
+// indices (sorted) of the objects that contain the point (see isContainingPoint)
+template <class ObjectRange>
+void findObjectsContainingPoint(const ObjectRange& objects, const sf::Vector2f point, std::vector<std::size_t>& indices)
+{
+	indices.clear();
+	const std::size_t numberOfObjects{ static_cast<std::size_t>(std::size(objects)) };
+	for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+	{
+		if (isContainingPoint(impl::getObject(objects[i]), point))
+			indices.push_back(i);
+	}
+}
+// indices (sorted) of the objects that collide with the (axis-aligned) rectangle
+// collision level is the same as for areColliding
+template <class ObjectRange>
+void findObjectsInRect(const ObjectRange& objects, const sf::FloatRect& rectangle, std::vector<std::size_t>& indices, const int collisionLevel = -1)
+{
+	indices.clear();
+	const CollisionProxy rectangleProxy(impl::RectangleObject{ rectangle });
+	const std::size_t numberOfObjects{ static_cast<std::size_t>(std::size(objects)) };
+	for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+	{
+		if (areColliding(rectangleProxy, CollisionProxy(impl::getObject(objects[i])), collisionLevel))
+			indices.push_back(i);
+	}
+}
+// finds the first object hit by the ray (a line segment from start to end)
+// returns false if no object is hit
+// ties go to the lowest index
+template <class ObjectRange>
+bool findFirstHit(const ObjectRange& objects, const sf::Vector2f start, const sf::Vector2f end, RayHit& hit)
+{
+	bool isHit{ false };
+	const std::size_t numberOfObjects{ static_cast<std::size_t>(std::size(objects)) };
+	for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+	{
+		float fraction;
+		if (!isHitByRay(impl::getObject(objects[i]), start, end, fraction) || (isHit && (fraction >= hit.fraction)))
+			continue;
+		isHit = true;
+		hit.index = i;
+		hit.fraction = fraction;
+	}
+	if (isHit)
+		hit.point = start + ((end - start) * hit.fraction);
+	return isHit;
+}
+
+// broad phase that finds all colliding pairs among many objects
+// uses a spatial hash (a uniform grid with no limits): each object is placed in every cell that its axis-aligned bounding box (level 0) overlaps
+//     only objects that share a cell are tested against each other and only pairs whose bounding boxes intersect are tested further (levels 1 and 2)
+//     each pair is tested once: only in the cell that contains the top-left corner of the intersection of their bounding boxes
+// cell size should be around the size of a typical object; an object much larger than a cell is placed in many cells
+//     it must be greater than zero (otherwise std::invalid_argument is thrown)
+// objects can be any random-access range of objects (or of pointers to objects) that can be tested with areColliding
+class SpatialHash
+{
+public:
+	explicit SpatialHash(const float cellSize = 64.f)
+	{
+		setCellSize(cellSize);
+	}
+	void setCellSize(const float cellSize)
+	{
+		if (!(cellSize > 0.f)) // also rejects NaN
+			throw std::invalid_argument("collision::SpatialHash: cell size must be greater than zero");
+		m_cellSize = cellSize;
+	}
+	float getCellSize() const
+	{
+		return m_cellSize;
+	}
+	// collisions are the indices (into objects) of each colliding pair, sorted by first and then by second
+	// collision level is the same as for areColliding
+	// no allocations are made once storage has grown to fit the objects
+	template <class ObjectRange>
+	void findCollisions(const ObjectRange& objects, std::vector<Pair>& collisions, const int collisionLevel = -1)
+	{
+		collisions.clear();
+		m_numberOfCandidatePairs = 0u;
+		const std::size_t numberOfObjects{ static_cast<std::size_t>(std::size(objects)) };
+		m_proxies.resize(numberOfObjects);
+		m_entries.clear();
+		for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+		{
+			m_proxies[i].update(impl::getObject(objects[i]));
+			const sf::FloatRect& bounds{ m_proxies[i].bounds };
+			const int left{ impl::getCellCoordinate(bounds.position.x, m_cellSize) };
+			const int top{ impl::getCellCoordinate(bounds.position.y, m_cellSize) };
+			const int right{ impl::getCellCoordinate(bounds.position.x + bounds.size.x, m_cellSize) };
+			const int bottom{ impl::getCellCoordinate(bounds.position.y + bounds.size.y, m_cellSize) };
+			for (int y{ top }; y <= bottom; ++y)
+			{
+				for (int x{ left }; x <= right; ++x)
+					m_entries.push_back({ impl::getCellKey(x, y), i });
+			}
+		}
+		std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) { return (a.cellKey < b.cellKey) || ((a.cellKey == b.cellKey) && (a.objectIndex < b.objectIndex)); });
+
+		// each run of entries with the same key is one cell
+		for (std::size_t cellBegin{ 0u }, cellEnd{ 0u }; cellBegin < m_entries.size(); cellBegin = cellEnd)
+		{
+			const std::uint64_t cellKey{ m_entries[cellBegin].cellKey };
+			for (cellEnd = cellBegin + 1u; (cellEnd < m_entries.size()) && (m_entries[cellEnd].cellKey == cellKey); ++cellEnd);
+			for (std::size_t a{ cellBegin }; a < cellEnd; ++a)
+			{
+				const std::size_t i{ m_entries[a].objectIndex };
+				const sf::FloatRect& boundsI{ m_proxies[i].bounds };
+				for (std::size_t b{ a + 1u }; b < cellEnd; ++b)
+				{
+					const std::size_t j{ m_entries[b].objectIndex };
+					const sf::FloatRect& boundsJ{ m_proxies[j].bounds };
+
+					// LEVEL 0 (same as areColliding)
+					const float intersectionLeft{ std::max(boundsI.position.x, boundsJ.position.x) };
+					const float intersectionTop{ std::max(boundsI.position.y, boundsJ.position.y) };
+					if ((intersectionLeft >= std::min(boundsI.position.x + boundsI.size.x, boundsJ.position.x + boundsJ.size.x)) ||
+						(intersectionTop >= std::min(boundsI.position.y + boundsI.size.y, boundsJ.position.y + boundsJ.size.y)))
+						continue;
+					if (impl::getCellKey(impl::getCellCoordinate(intersectionLeft, m_cellSize), impl::getCellCoordinate(intersectionTop, m_cellSize)) != cellKey)
+						continue;
+
+					++m_numberOfCandidatePairs;
+					if ((collisionLevel == 0) || impl::areCollidingBeyondLevel0(m_proxies[i], m_proxies[j], collisionLevel))
+						collisions.push_back({ i, j });
+				}
+			}
+		}
+		std::sort(collisions.begin(), collisions.end(), [](const Pair& a, const Pair& b) { return (a.first < b.first) || ((a.first == b.first) && (a.second < b.second)); });
+	}
+	// number of pairs (from the most recent findCollisions) whose bounding boxes intersect, i.e. the pairs that were tested further
+	std::size_t getNumberOfCandidatePairs() const
+	{
+		return m_numberOfCandidatePairs;
+	}
+
+private:
+	struct Entry
+	{
+		std::uint64_t cellKey;
+		std::size_t objectIndex;
+	};
+
+	float m_cellSize{ 64.f };
+	std::vector<CollisionProxy> m_proxies{};
+	std::vector<Entry> m_entries{};
+	std::size_t m_numberOfCandidatePairs{ 0u };
+};
+
+
+
+	namespace impl
+	{
+
+template <class T1, class T2>
+bool areCollidingBeyondLevel0(const T1& object1, const sf::Transform& transform1, const T2& object2, const sf::Transform& transform2, const int collisionLevel)
+{
+	CollisionProxy proxy1;
+	CollisionProxy proxy2;
+	updateProxyCorners(proxy1, object1, transform1);
+	updateProxyCorners(proxy2, object2, transform2);
+	return areCollidingBeyondLevel0(proxy1, proxy2, collisionLevel);
+}
+
+inline bool areCollidingBeyondLevel0(const CollisionProxy& proxy1, const CollisionProxy& proxy2, const int collisionLevel)
+{
+	return (collisionLevel == 1) ? areCollidingBeyondLevel0<1>(proxy1, proxy2) : areCollidingBeyondLevel0<-1>(proxy1, proxy2);
+}
+
+template <int collisionLevel>
+bool areCollidingBeyondLevel0(const CollisionProxy& proxy1, const CollisionProxy& proxy2)
+{
 	// LEVEL 1 (any corners inside opposite rectangle)
-	const sf::Transform inverseTransform1{ object1.getInverseTransform() };
-	const sf::Transform inverseTransform2{ object2.getInverseTransform() };
-	const sf::FloatRect rect1Bounds{ object1.getLocalBounds() };
-	const sf::FloatRect rect2Bounds{ object2.getLocalBounds() };
-	const sf::Vector2f rect1TopLeft{ inverseTransform2.transformPoint(transform1.transformPoint({ 0.f, 0.f })) };
-	const sf::Vector2f rect1TopRight{ inverseTransform2.transformPoint(transform1.transformPoint({ rect1Bounds.size.x, 0.f })) };
-	const sf::Vector2f rect1BottomRight{ inverseTransform2.transformPoint(transform1.transformPoint(rect1Bounds.size)) };
-	const sf::Vector2f rect1BottomLeft{ inverseTransform2.transformPoint(transform1.transformPoint({ 0.f, rect1Bounds.size.y })) };
-	const sf::Vector2f rect2TopLeft{ inverseTransform1.transformPoint(transform2.transformPoint({ 0.f, 0.f })) };
-	const sf::Vector2f rect2TopRight{ inverseTransform1.transformPoint(transform2.transformPoint({ rect2Bounds.size.x, 0.f })) };
-	const sf::Vector2f rect2BottomRight{ inverseTransform1.transformPoint(transform2.transformPoint(rect2Bounds.size)) };
-	const sf::Vector2f rect2BottomLeft{ inverseTransform1.transformPoint(transform2.transformPoint({ 0.f, rect2Bounds.size.y })) };
+	const sf::FloatRect& rect1Bounds{ proxy1.localBounds };
+	const sf::FloatRect& rect2Bounds{ proxy2.localBounds };
+	const sf::Vector2f rect1TopLeft{ proxy2.inverseTransform.transformPoint(proxy1.corners[0u]) };
+	const sf::Vector2f rect1TopRight{ proxy2.inverseTransform.transformPoint(proxy1.corners[1u]) };
+	const sf::Vector2f rect1BottomRight{ proxy2.inverseTransform.transformPoint(proxy1.corners[2u]) };
+	const sf::Vector2f rect1BottomLeft{ proxy2.inverseTransform.transformPoint(proxy1.corners[3u]) };
+	const sf::Vector2f rect2TopLeft{ proxy1.inverseTransform.transformPoint(proxy2.corners[0u]) };
+	const sf::Vector2f rect2TopRight{ proxy1.inverseTransform.transformPoint(proxy2.corners[1u]) };
+	const sf::Vector2f rect2BottomRight{ proxy1.inverseTransform.transformPoint(proxy2.corners[2u]) };
+	const sf::Vector2f rect2BottomLeft{ proxy1.inverseTransform.transformPoint(proxy2.corners[3u]) };
 	const bool level1{ (
 		(rect1Bounds.contains(rect2TopLeft)) ||
 		(rect1Bounds.contains(rect2TopRight)) ||
@@ -57,35 +548,334 @@ bool areColliding(const T1& object1, const T2& object2, const int collisionLevel
 		(rect2Bounds.contains(rect1TopRight)) ||
 		(rect2Bounds.contains(rect1BottomLeft)) ||
 		(rect2Bounds.contains(rect1BottomRight))) };
-	if (level1 || collisionLevel == 1)
+	if constexpr (collisionLevel == 1)
 		return level1;
+	else
+	{
+		if (level1)
+			return true;
 
-	// LEVEL 2 (SAT)
-	std::array<sf::Vector2f, 4> rect1Points
+		// LEVEL 2 (SAT)
+		std::array<sf::Vector2f, 4> rect1Points
+		{
+			rect1BottomLeft,
+			rect1BottomRight,
+			rect1TopRight,
+			rect1TopLeft,
+		};
+		if (!impl::satRectangleAndPoints(rect2Bounds.size, rect1Points))
+			return false;
+		std::array<sf::Vector2f, 4> rect2Points
+		{
+			rect2BottomLeft,
+			rect2BottomRight,
+			rect2TopRight,
+			rect2TopLeft,
+		};
+		return impl::satRectangleAndPoints(rect1Bounds.size, rect2Points);
+	}
+}
+
+inline bool isAxisAligned(const sf::Transform& transform)
+{
+	const float* const matrix{ transform.getMatrix() };
+	return (matrix[1u] == 0.f) && (matrix[4u] == 0.f);
+}
+
+template <class T>
+sf::FloatRect getAxisAlignedBounds(const T& object)
+{
+	// the other two corners share these corners' coordinates exactly since the transform has no rotation or skew
+	const sf::Transform transform{ object.getTransform() };
+	const sf::FloatRect localBounds{ object.getLocalBounds() };
+	const sf::Vector2f corner1{ transform.transformPoint(localBounds.position) };
+	const sf::Vector2f corner2{ transform.transformPoint(localBounds.position + localBounds.size) };
+	const sf::Vector2f topLeft{ std::min(corner1.x, corner2.x), std::min(corner1.y, corner2.y) };
+	return { topLeft, { std::max(corner1.x, corner2.x) - topLeft.x, std::max(corner1.y, corner2.y) - topLeft.y } };
+}
+
+inline void findShallowestAxis(const CollisionProxy& rectangle, const CollisionProxy& other, const bool isRectangleFirst, Contact& contact, bool& hasAxis)
+{
+	// the other's corners in the rectangle's local coordinates are their projections onto the rectangle's axes
+	// the rectangle's projections are from 0 to its size (as in satRectangleAndPoints)
+	std::array<sf::Vector2f, 4> points{};
+	for (std::size_t corner{ 0u }; corner < 4u; ++corner)
+		points[corner] = rectangle.inverseTransform.transformPoint(other.corners[corner]);
+
+	// overlaps in local coordinates are converted to world distances by dividing by the length of the inverse transform's row for that axis
+	// (the row is also the axis' direction in world coordinates)
+	const float* const matrix{ rectangle.inverseTransform.getMatrix() };
+	for (std::size_t axis{ 0u }; axis < 2u; ++axis)
 	{
-		rect1BottomLeft,
-		rect1BottomRight,
-		rect1TopRight,
-		rect1TopLeft,
-	};
-	if (!impl::satRectangleAndPoints(rect2Bounds.size, rect1Points))
-		return false;
-	std::array<sf::Vector2f, 4> rect2Points
+		const sf::Vector2f row{ (axis == 0u) ? sf::Vector2f{ matrix[0u], matrix[4u] } : sf::Vector2f{ matrix[1u], matrix[5u] } };
+		const float rowLength{ row.length() };
+		if (rowLength == 0.f)
+			continue;
+		const float size{ (axis == 0u) ? rectangle.localBounds.size.x : rectangle.localBounds.size.y };
+		std::size_t minimumCorner{ 0u };
+		std::size_t maximumCorner{ 0u };
+		for (std::size_t corner{ 1u }; corner < 4u; ++corner)
+		{
+			const float value{ (axis == 0u) ? points[corner].x : points[corner].y };
+			if (value < ((axis == 0u) ? points[minimumCorner].x : points[minimumCorner].y))
+				minimumCorner = corner;
+			if (value > ((axis == 0u) ? points[maximumCorner].x : points[maximumCorner].y))
+				maximumCorner = corner;
+		}
+		const float minimum{ (axis == 0u) ? points[minimumCorner].x : points[minimumCorner].y };
+		const float maximum{ (axis == 0u) ? points[maximumCorner].x : points[maximumCorner].y };
+		const sf::Vector2f direction{ row / rowLength };
+
+		// the other can be pushed out either way along the axis: forwards (past the rectangle's far edge) or backwards (past its near edge)
+		const float forwardsOverlap{ (size - minimum) / rowLength };
+		const float backwardsOverlap{ maximum / rowLength };
+		const bool isForwards{ forwardsOverlap < backwardsOverlap };
+		const float overlap{ isForwards ? forwardsOverlap : backwardsOverlap };
+		if (hasAxis && (overlap >= contact.depth))
+			continue;
+		hasAxis = true;
+		contact.depth = overlap;
+		const sf::Vector2f pushDirection{ isForwards ? direction : -direction }; // direction that the other is pushed out of the rectangle
+		contact.normal = isRectangleFirst ? pushDirection : -pushDirection;
+		contact.point = other.corners[isForwards ? minimumCorner : maximumCorner];
+	}
+}
+
+inline bool findTimeOfImpactOfCorners(const std::array<sf::Vector2f, 4>& corners1, const std::array<sf::Vector2f, 4>& corners2, const sf::Vector2f displacement, float& time)
+{
+	// axes do not need to be of unit length: the times along each are the same at any length
+	std::array<sf::Vector2f, 4> axes{};
+	std::size_t numberOfAxes{ 0u };
+	for (const std::array<sf::Vector2f, 4>* corners : { &corners1, &corners2 })
 	{
-		rect2BottomLeft,
-		rect2BottomRight,
-		rect2TopRight,
-		rect2TopLeft,
-	};
-	return impl::satRectangleAndPoints(rect1Bounds.size, rect2Points);
+		const sf::Vector2f edge1{ (*corners)[1u] - (*corners)[0u] };
+		const sf::Vector2f edge2{ (*corners)[3u] - (*corners)[0u] };
+		const bool isEdge1Zero{ (edge1.x == 0.f) && (edge1.y == 0.f) };
+		const bool isEdge2Zero{ (edge2.x == 0.f) && (edge2.y == 0.f) };
+		if (isEdge1Zero && isEdge2Zero)
+		{
+			axes[numberOfAxes++] = { 1.f, 0.f };
+			axes[numberOfAxes++] = { 0.f, 1.f };
+		}
+		else if (isEdge1Zero || isEdge2Zero)
+		{
+			const sf::Vector2f edge{ isEdge1Zero ? edge2 : edge1 };
+			axes[numberOfAxes++] = edge.perpendicular();
+			axes[numberOfAxes++] = edge;
+		}
+		else
+		{
+			axes[numberOfAxes++] = edge1.perpendicular();
+			axes[numberOfAxes++] = edge2.perpendicular();
+		}
+	}
+
+	// each axis gives the times that the projections of both sets overlap (they are separated on that axis at any other time)
+	float enterTime{ 0.f };
+	float exitTime{ 1.f };
+	for (const sf::Vector2f axis : axes)
+	{
+		float minimum1{ axis.dot(corners1[0u]) };
+		float maximum1{ minimum1 };
+		float minimum2{ axis.dot(corners2[0u]) };
+		float maximum2{ minimum2 };
+		for (std::size_t corner{ 1u }; corner < 4u; ++corner)
+		{
+			const float value1{ axis.dot(corners1[corner]) };
+			const float value2{ axis.dot(corners2[corner]) };
+			minimum1 = std::min(minimum1, value1);
+			maximum1 = std::max(maximum1, value1);
+			minimum2 = std::min(minimum2, value2);
+			maximum2 = std::max(maximum2, value2);
+		}
+		const float speed{ axis.dot(displacement) };
+		if (speed == 0.f)
+		{
+			if ((maximum2 < minimum1) || (minimum2 > maximum1))
+				return false;
+			continue;
+		}
+		const float time1{ (minimum1 - maximum2) / speed };
+		const float time2{ (maximum1 - minimum2) / speed };
+		enterTime = std::max(enterTime, std::min(time1, time2));
+		exitTime = std::min(exitTime, std::max(time1, time2));
+		if (enterTime > exitTime)
+			return false;
+	}
+	time = enterTime;
+	return true;
 }
 
+inline bool findTimeOfImpactOfRotatingCorners(const std::array<sf::Vector2f, 4>& corners1, const sf::Vector2f pivot1, const sf::Vector2f displacement1, const float rotation1, const std::array<sf::Vector2f, 4>& corners2, const sf::Vector2f pivot2, const sf::Vector2f displacement2, const float rotation2, const float tolerance, float& time)
+{
+	constexpr std::size_t maximumNumberOfSteps{ 64u };
 
+	// no point can move faster (in world units per step) than the linear speed plus the rotation speed multiplied by its distance from the pivot
+	float radius1{ 0.f };
+	float radius2{ 0.f };
+	for (std::size_t corner{ 0u }; corner < 4u; ++corner)
+	{
+		radius1 = std::max(radius1, (corners1[corner] - pivot1).length());
+		radius2 = std::max(radius2, (corners2[corner] - pivot2).length());
+	}
+	const float rotationSpeed{ (std::abs(rotation1) * radius1) + (std::abs(rotation2) * radius2) };
 
-	namespace impl
+	float currentTime{ 0.f };
+	for (std::size_t step{ 0u }; step < maximumNumberOfSteps; ++step)
 	{
+		std::array<sf::Vector2f, 4> movedCorners1{};
+		std::array<sf::Vector2f, 4> movedCorners2{};
+		const sf::Transform transform1{ sf::Transform().translate(displacement1 * currentTime).rotate(sf::radians(rotation1 * currentTime), pivot1) };
+		const sf::Transform transform2{ sf::Transform().translate(displacement2 * currentTime).rotate(sf::radians(rotation2 * currentTime), pivot2) };
+		for (std::size_t corner{ 0u }; corner < 4u; ++corner)
+		{
+			movedCorners1[corner] = transform1.transformPoint(corners1[corner]);
+			movedCorners2[corner] = transform2.transformPoint(corners2[corner]);
+		}
+
+		float touchTime{};
+		if (findTimeOfImpactOfCorners(movedCorners1, movedCorners2, { 0.f, 0.f }, touchTime))
+		{
+			time = currentTime;
+			return true;
+		}
+		sf::Vector2f normal{};
+		const float distance{ findDistanceBetweenCorners(movedCorners1, movedCorners2, normal) };
+		if (distance <= tolerance)
+		{
+			time = currentTime;
+			return true;
+		}
+
+		// the gap along normal cannot close faster than this so the objects cannot touch before the gap has been (mostly) closed at this speed
+		// (half of the tolerance is left so that the next step is never past the time that they touch, even with rounding)
+		const float approachSpeed{ std::max(0.f, normal.dot(displacement1 - displacement2)) + rotationSpeed };
+		if (approachSpeed <= 0.f)
+			return false;
+		currentTime += (distance - (tolerance * 0.5f)) / approachSpeed;
+		if (currentTime > 1.f)
+			return false;
+	}
+	time = currentTime;
+	return true;
+}
+
+inline float findDistanceBetweenCorners(const std::array<sf::Vector2f, 4>& corners1, const std::array<sf::Vector2f, 4>& corners2, sf::Vector2f& normal)
+{
+	// the closest points of two convex shapes that are not touching always include (at least) one corner
+	float shortestDistanceSquared{ -1.f };
+	for (const bool isCorner1 : { true, false })
+	{
+		const std::array<sf::Vector2f, 4>& corners{ isCorner1 ? corners1 : corners2 };
+		const std::array<sf::Vector2f, 4>& edges{ isCorner1 ? corners2 : corners1 };
+		for (const sf::Vector2f corner : corners)
+		{
+			for (std::size_t edge{ 0u }; edge < 4u; ++edge)
+			{
+				const sf::Vector2f edgeStart{ edges[edge] };
+				const sf::Vector2f edgeVector{ edges[(edge + 1u) % 4u] - edgeStart };
+				const float edgeLengthSquared{ edgeVector.lengthSquared() };
+				const float fraction{ (edgeLengthSquared == 0.f) ? 0.f : std::clamp((corner - edgeStart).dot(edgeVector) / edgeLengthSquared, 0.f, 1.f) };
+				const sf::Vector2f offset{ edgeStart + (edgeVector * fraction) - corner };
+				const float distanceSquared{ offset.lengthSquared() };
+				if ((shortestDistanceSquared >= 0.f) && (distanceSquared >= shortestDistanceSquared))
+					continue;
+				shortestDistanceSquared = distanceSquared;
+				normal = isCorner1 ? offset : -offset;
+			}
+		}
+	}
+	const float distance{ std::sqrt(shortestDistanceSquared) };
+	if (distance > 0.f)
+		normal /= distance;
+	return distance;
+}
+
+template <class T>
+void updateProxyCorners(CollisionProxy& proxy, const T& object, const sf::Transform& transform)
+{
+	proxy.inverseTransform = object.getInverseTransform();
+	proxy.localBounds = object.getLocalBounds();
+	proxy.corners[0u] = transform.transformPoint({ 0.f, 0.f });
+	proxy.corners[1u] = transform.transformPoint({ proxy.localBounds.size.x, 0.f });
+	proxy.corners[2u] = transform.transformPoint(proxy.localBounds.size);
+	proxy.corners[3u] = transform.transformPoint({ 0.f, proxy.localBounds.size.y });
+}
+
+template <class T>
+const std::remove_pointer_t<std::remove_cv_t<T>>& getObject(const T& object)
+{
+	if constexpr (std::is_pointer_v<std::remove_cv_t<T>>)
+		return *object;
+	else
+		return object;
+}
+
+inline int getCellCoordinate(const float value, const float cellSize)
+{
+	constexpr float limit{ 1073741824.f }; // 2^30
+	return static_cast<int>(std::floor(std::clamp(value / cellSize, -limit, limit)));
+}
+
+inline std::uint64_t getCellKey(const int x, const int y)
+{
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)) << 32u) | static_cast<std::uint32_t>(x);
+}
+
+inline bool areBoundsIntersecting(const sf::FloatRect& bounds1, const sf::FloatRect& bounds2)
+{
+	return (std::max(bounds1.position.x, bounds2.position.x) < std::min(bounds1.position.x + bounds1.size.x, bounds2.position.x + bounds2.size.x)) &&
+		(std::max(bounds1.position.y, bounds2.position.y) < std::min(bounds1.position.y + bounds1.size.y, bounds2.position.y + bounds2.size.y));
+}
+
+inline bool rayHitsRectangle(const sf::FloatRect& rectangle, const sf::Vector2f start, const sf::Vector2f end, float& fraction, const float maximumFraction)
+{
+	return rayHitsRectangle(rectangle.position, rectangle.position + rectangle.size, start, end, fraction, maximumFraction);
+}
+
+inline bool rayHitsRectangle(const sf::Vector2f topLeft, const sf::Vector2f bottomRight, const sf::Vector2f start, const sf::Vector2f end, float& fraction, const float maximumFraction)
+{
+	// slab test
+	const sf::Vector2f direction{ end - start };
+	float minimum{ 0.f };
+	float maximum{ maximumFraction };
+	for (const auto& [rectangleStart, rectangleEnd, rayStart, rayDirection] : { std::array<float, 4u>{ topLeft.x, bottomRight.x, start.x, direction.x }, std::array<float, 4u>{ topLeft.y, bottomRight.y, start.y, direction.y } })
+	{
+		if (rayDirection == 0.f)
+		{
+			if ((rayStart < rectangleStart) || (rayStart > rectangleEnd))
+				return false;
+			continue;
+		}
+		float entryFraction{ (rectangleStart - rayStart) / rayDirection };
+		float exitFraction{ (rectangleEnd - rayStart) / rayDirection };
+		if (entryFraction > exitFraction)
+			std::swap(entryFraction, exitFraction);
+		minimum = std::max(minimum, entryFraction);
+		maximum = std::min(maximum, exitFraction);
+		if (minimum > maximum)
+			return false;
+	}
+	fraction = minimum;
+	return true;
+}
+
+inline sf::Transform RectangleObject::getTransform() const
+{
+	return sf::Transform().translate(rectangle.position);
+}
+
+inline sf::Transform RectangleObject::getInverseTransform() const
+{
+	return sf::Transform().translate(-rectangle.position);
+}
+
+inline sf::FloatRect RectangleObject::getLocalBounds() const
+{
+	return { { 0.f, 0.f }, rectangle.size };
+}
 
-bool satRectangleAndPoints(const sf::Vector2f rectangleSize, const std::array<sf::Vector2f, 4>& points)
+inline bool satRectangleAndPoints(const sf::Vector2f rectangleSize, const std::array<sf::Vector2f, 4>& points)
 {
 	bool allPointsLeftOfRectangle{ true };
 	bool allPointsRightOfRectangle{ true };
@@ -0,0 +1,540 @@
+////////////////////////////////////////////////////////////////
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017-2026 M.J.Silk
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//
+//       ------------
+//       INTRODUCTION
+//       ------------
+//
+//   Tests and times collision::areColliding without opening a window (nothing is drawn).
+//   Millions of random pairs of transformed rectangles are tested at each collision level (0, 1 and 2) and compared with a reference.
+//   The reference finds the corners in double precision (from the same transforms) and intersects the two polygons exactly, using every separating axis.
+//   Pairs are generated in these categories:
+//     - random: any position, size, origin, rotation and scale (including flips)
+//     - axis-aligned: no rotation with whole-number positions, sizes and origins (so edges often touch exactly)
+//     - touching: the second rectangle is a copy of the first moved along its edges so that they share an edge or a corner, or overlap by half
+//     - degenerate: one or both rectangles have zero width and/or height (points and line segments)
+//   Each level is tested with both collision::areColliding (level chosen at run time) and collision::areCollidingAtLevel (level chosen at compile time, with its axis-aligned fast path at level 2).
+//   The axis-aligned category is also tested with collision::areCollidingAxisAligned (the rectangles are declared to be axis-aligned), which is recorded as level 2 since it should be just as exact.
+//   For each category, level and function, these are recorded:
+//     - time per test (nanoseconds): the mean over all pairs
+//     - colliding rate: the proportion of pairs that the reference finds are colliding
+//     - touching rate: the proportion of pairs that the reference finds are only touching (within touchingTolerance); either result is accepted for these
+//     - false positive rate: the proportion of pairs that are not colliding (and not touching) that the test says are colliding
+//     - false negative rate: the proportion of pairs that are colliding (and not touching) that the test says are not colliding
+//     - exit rates: the proportion of tests that finish at each level (a level only continues to the next if it cannot be certain of the result)
+//     - difference rate: the proportion of pairs whose result differs from collision::areColliding at the same level (always 0 for collision::areColliding itself)
+//   The results are written as CSV (with a header line), one line per category, level and function.
+//   collision::CollisionProxySet is also checked: for each category and level, a set of rectangles (whose size is not a multiple of the SIMD lane width) is tested against each rectangle in turn,
+//   once with its SIMD calculations (findCollisions) and once with its scalar calculations (findCollisionsScalar). Any query whose results differ is reported (to the standard error).
+//   The picking queries (collision::findObjectsContainingPoint, collision::findObjectsInRect and collision::findFirstHit) are also checked: random points, rectangles and rays are queried
+//   over a range of random rectangles and over a range of pointers to the same rectangles. Any query whose results differ is reported (to the standard error).
+//   Returns failure if level 2 gives any wrong results outside of the degenerate category, if collision::areCollidingAtLevel differs at all from collision::areColliding at level 0 or 1, if the SIMD and scalar results of collision::CollisionProxySet differ at all
+//   or if any picking query differs between the range of rectangles and the range of pointers.
+//
+//
+//       -----
+//       USAGE
+//       -----
+//
+//   RectangularBoundaryCollision_harness [output file] [number of pairs per category] [seed]
+//
+//   The results are written to the output file if one is given, otherwise to the standard output.
+//   The number of pairs per category is 1000000 by default.
+//
+//
+//       -------------
+//       CUSTOMISATION
+//       -------------
+//
+//   You can change how close to touching counts as touching using this line: constexpr double touchingTolerance{ 0.001 };
+//   You can change how many pairs are created and tested at once using this line: constexpr std::size_t batchSize{ 8192u };
+//   You can change the number of rectangles in the collision::CollisionProxySet using this line: constexpr std::size_t proxySetSize{ 1003u };
+//   You can change the number of rectangles (and of each type of query) used to check the picking queries using this line: constexpr std::size_t pickingSize{ 1000u };
+//
+//
+//        ----
+//        NOTE
+//        ----
+//
+//    No window or OpenGL context is needed.
+//    You may also need to adjust the path of the included headers ("RectangularBoundaryCollision.hpp" and "CollisionProxySet.hpp") depending on your approach.
+//    Remember to build in release mode. Timings in debug mode are not meaningful.
+//
+//    This harness is for use with SFML 3.
+//
+//
+////////////////////////////////////////////////////////////////
+
+
+
+#include <SFML/Graphics.hpp>
+
+#include "../RectangularBoundaryCollision/RectangularBoundaryCollision.hpp"
+#include "../RectangularBoundaryCollision/CollisionProxySet.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+constexpr double touchingTolerance{ 0.001 }; // pairs whose reference separation (or overlap) is within this distance are counted as touching
+constexpr std::size_t batchSize{ 8192u };
+constexpr std::size_t proxySetSize{ 1003u }; // not a multiple of the lane width (4 or 8) so the scalar remainder is also used
+constexpr std::size_t pickingSize{ 1000u };
+
+// the lightest object that can be tested with areColliding
+struct Rectangle : public sf::Transformable
+{
+	sf::Vector2f size;
+
+	sf::FloatRect getLocalBounds() const
+	{
+		return { { 0.f, 0.f }, size };
+	}
+};
+
+enum class Function
+{
+	RunTimeLevel,
+	CompileTimeLevel,
+	DeclaredAxisAligned,
+};
+
+enum class Category
+{
+	Random,
+	AxisAligned,
+	Touching,
+	Degenerate,
+};
+
+struct Result
+{
+	std::size_t numberOfPairs;
+	double totalNanoseconds;
+	std::size_t numberOfColliding;
+	std::size_t numberOfTouching;
+	std::size_t numberOfSeparate;
+	std::size_t numberOfFalsePositives;
+	std::size_t numberOfFalseNegatives;
+	std::array<std::size_t, 3> numberOfExits;
+	std::size_t numberOfDifferences; // from areColliding at the same level
+};
+
+bool isAxisAligned(const Rectangle& rectangle)
+{
+	const sf::Transform transform{ rectangle.getTransform() };
+	const float* const matrix{ transform.getMatrix() };
+	return (matrix[1u] == 0.f) && (matrix[4u] == 0.f);
+}
+
+template <int collisionLevel>
+void testAtCompileTimeLevel(const std::vector<Rectangle>& rectangles1, const std::vector<Rectangle>& rectangles2, std::vector<char>& results, const std::size_t numberOfPairs)
+{
+	for (std::size_t i{ 0u }; i < numberOfPairs; ++i)
+		results[i] = collision::areCollidingAtLevel<collisionLevel>(rectangles1[i], rectangles2[i]);
+}
+
+using ReferenceCorners = std::array<std::array<double, 2>, 4>;
+
+ReferenceCorners getReferenceCorners(const Rectangle& rectangle)
+{
+	const sf::Transform transform{ rectangle.getTransform() };
+	const float* const matrix{ transform.getMatrix() };
+	const std::array<std::array<double, 2>, 4> localCorners{ { { 0.0, 0.0 }, { rectangle.size.x, 0.0 }, { rectangle.size.x, rectangle.size.y }, { 0.0, rectangle.size.y } } };
+	ReferenceCorners corners{};
+	for (std::size_t i{ 0u }; i < 4u; ++i)
+	{
+		corners[i][0u] = (static_cast<double>(matrix[0u]) * localCorners[i][0u]) + (static_cast<double>(matrix[4u]) * localCorners[i][1u]) + matrix[12u];
+		corners[i][1u] = (static_cast<double>(matrix[1u]) * localCorners[i][0u]) + (static_cast<double>(matrix[5u]) * localCorners[i][1u]) + matrix[13u];
+	}
+	return corners;
+}
+
+// the separating axes of a (possibly degenerate) parallelogram: the normals of its edges
+// a line segment also needs its own direction and a point needs both world axes
+void addReferenceAxes(const ReferenceCorners& corners, std::vector<std::array<double, 2>>& axes)
+{
+	const std::array<double, 2> edge1{ corners[1u][0u] - corners[0u][0u], corners[1u][1u] - corners[0u][1u] };
+	const std::array<double, 2> edge2{ corners[3u][0u] - corners[0u][0u], corners[3u][1u] - corners[0u][1u] };
+	const bool isEdge1Zero{ (edge1[0u] == 0.0) && (edge1[1u] == 0.0) };
+	const bool isEdge2Zero{ (edge2[0u] == 0.0) && (edge2[1u] == 0.0) };
+	if (isEdge1Zero && isEdge2Zero)
+	{
+		axes.push_back({ 1.0, 0.0 });
+		axes.push_back({ 0.0, 1.0 });
+	}
+	else if (isEdge1Zero || isEdge2Zero)
+	{
+		const std::array<double, 2> edge{ isEdge1Zero ? edge2 : edge1 };
+		axes.push_back({ -edge[1u], edge[0u] });
+		axes.push_back(edge);
+	}
+	else
+	{
+		axes.push_back({ -edge1[1u], edge1[0u] });
+		axes.push_back({ -edge2[1u], edge2[0u] });
+	}
+}
+
+// the largest gap between the two polygons along any of their separating axes (in world units)
+// positive if they are separate, zero if they only touch and negative if they overlap
+double getReferenceSeparation(const Rectangle& rectangle1, const Rectangle& rectangle2)
+{
+	const ReferenceCorners corners1{ getReferenceCorners(rectangle1) };
+	const ReferenceCorners corners2{ getReferenceCorners(rectangle2) };
+	std::vector<std::array<double, 2>> axes;
+	addReferenceAxes(corners1, axes);
+	addReferenceAxes(corners2, axes);
+
+	double separation{ -std::numeric_limits<double>::infinity() };
+	for (const auto& axis : axes)
+	{
+		double minimum1{ std::numeric_limits<double>::infinity() };
+		double maximum1{ -std::numeric_limits<double>::infinity() };
+		double minimum2{ std::numeric_limits<double>::infinity() };
+		double maximum2{ -std::numeric_limits<double>::infinity() };
+		for (std::size_t i{ 0u }; i < 4u; ++i)
+		{
+			const double value1{ (corners1[i][0u] * axis[0u]) + (corners1[i][1u] * axis[1u]) };
+			const double value2{ (corners2[i][0u] * axis[0u]) + (corners2[i][1u] * axis[1u]) };
+			minimum1 = std::min(minimum1, value1);
+			maximum1 = std::max(maximum1, value1);
+			minimum2 = std::min(minimum2, value2);
+			maximum2 = std::max(maximum2, value2);
+		}
+		const double gap{ std::max(minimum2 - maximum1, minimum1 - maximum2) / std::sqrt((axis[0u] * axis[0u]) + (axis[1u] * axis[1u])) };
+		separation = std::max(separation, gap);
+	}
+	return separation;
+}
+
+void randomiseRectangle(Rectangle& rectangle, std::mt19937& randomGenerator, const Category category)
+{
+	std::uniform_real_distribution<float> position(0.f, 200.f);
+	std::uniform_real_distribution<float> size(1.f, 50.f);
+	std::uniform_real_distribution<float> unit(0.f, 1.f);
+	std::uniform_real_distribution<float> degrees(0.f, 360.f);
+	std::uniform_real_distribution<float> scale(0.25f, 2.f);
+	std::uniform_int_distribution<int> wholePosition(0, 100);
+	std::uniform_int_distribution<int> wholeSize(1, 40);
+	std::bernoulli_distribution flip(0.25);
+
+	if (category == Category::AxisAligned)
+	{
+		rectangle.size = { static_cast<float>(wholeSize(randomGenerator)), static_cast<float>(wholeSize(randomGenerator)) };
+		rectangle.setOrigin({ static_cast<float>(wholePosition(randomGenerator) % 10), static_cast<float>(wholePosition(randomGenerator) % 10) });
+		rectangle.setPosition({ static_cast<float>(wholePosition(randomGenerator)), static_cast<float>(wholePosition(randomGenerator)) });
+		rectangle.setRotation(sf::Angle::Zero);
+		rectangle.setScale({ flip(randomGenerator) ? -1.f : 1.f, flip(randomGenerator) ? -1.f : 1.f });
+		return;
+	}
+
+	rectangle.size = { size(randomGenerator), size(randomGenerator) };
+	rectangle.setOrigin({ rectangle.size.x * unit(randomGenerator), rectangle.size.y * unit(randomGenerator) });
+	rectangle.setPosition({ position(randomGenerator), position(randomGenerator) });
+	rectangle.setRotation(sf::degrees(degrees(randomGenerator)));
+	rectangle.setScale({ scale(randomGenerator) * (flip(randomGenerator) ? -1.f : 1.f), scale(randomGenerator) * (flip(randomGenerator) ? -1.f : 1.f) });
+	if (category == Category::Degenerate)
+	{
+		switch (randomGenerator() % 3u)
+		{
+		case 0u:
+			rectangle.size.x = 0.f;
+			break;
+		case 1u:
+			rectangle.size.y = 0.f;
+			break;
+		default:
+			rectangle.size = { 0.f, 0.f };
+			break;
+		}
+	}
+}
+
+void createPair(Rectangle& rectangle1, Rectangle& rectangle2, std::mt19937& randomGenerator, const Category category)
+{
+	randomiseRectangle(rectangle1, randomGenerator, category);
+	if (category != Category::Touching)
+	{
+		randomiseRectangle(rectangle2, randomGenerator, (category == Category::Degenerate) && ((randomGenerator() % 2u) == 0u) ? Category::Random : category);
+		return;
+	}
+
+	// a copy moved by whole or half edges (in world coordinates)
+	if ((randomGenerator() % 2u) == 0u)
+		randomiseRectangle(rectangle1, randomGenerator, Category::AxisAligned);
+	rectangle2 = rectangle1;
+	const sf::Transform transform{ rectangle1.getTransform() };
+	const sf::Vector2f edgeX{ transform.transformPoint({ rectangle1.size.x, 0.f }) - transform.transformPoint({ 0.f, 0.f }) };
+	const sf::Vector2f edgeY{ transform.transformPoint({ 0.f, rectangle1.size.y }) - transform.transformPoint({ 0.f, 0.f }) };
+	constexpr float multiples[]{ -1.f, -0.5f, 0.f, 0.5f, 1.f };
+	rectangle2.move((edgeX * multiples[randomGenerator() % 5u]) + (edgeY * multiples[randomGenerator() % 5u]));
+}
+
+Result runTest(const Category category, const int collisionLevel, const Function function, const std::size_t numberOfPairs, const unsigned int seed)
+{
+	std::mt19937 randomGenerator{ seed + static_cast<unsigned int>(category) }; // same pairs for every level
+	std::vector<Rectangle> rectangles1(batchSize);
+	std::vector<Rectangle> rectangles2(batchSize);
+	std::vector<double> separations(batchSize);
+	std::vector<char> results(batchSize);
+	Result result{};
+
+	for (std::size_t batchStart{ 0u }; batchStart < numberOfPairs; batchStart += batchSize)
+	{
+		const std::size_t numberOfPairsInBatch{ std::min(batchSize, numberOfPairs - batchStart) };
+		for (std::size_t i{ 0u }; i < numberOfPairsInBatch; ++i)
+		{
+			createPair(rectangles1[i], rectangles2[i], randomGenerator, category);
+			separations[i] = getReferenceSeparation(rectangles1[i], rectangles2[i]);
+			rectangles1[i].getInverseTransform(); // transforms are calculated (and stored) here so that they are not timed
+			rectangles2[i].getInverseTransform();
+		}
+
+		const auto start{ std::chrono::steady_clock::now() };
+		if (function == Function::RunTimeLevel)
+		{
+			for (std::size_t i{ 0u }; i < numberOfPairsInBatch; ++i)
+				results[i] = collision::areColliding(rectangles1[i], rectangles2[i], collisionLevel);
+		}
+		else if (function == Function::DeclaredAxisAligned)
+		{
+			for (std::size_t i{ 0u }; i < numberOfPairsInBatch; ++i)
+				results[i] = collision::areCollidingAxisAligned(rectangles1[i], rectangles2[i]);
+		}
+		else if (collisionLevel == 0)
+			testAtCompileTimeLevel<0>(rectangles1, rectangles2, results, numberOfPairsInBatch);
+		else if (collisionLevel == 1)
+			testAtCompileTimeLevel<1>(rectangles1, rectangles2, results, numberOfPairsInBatch);
+		else
+			testAtCompileTimeLevel<2>(rectangles1, rectangles2, results, numberOfPairsInBatch);
+		const auto end{ std::chrono::steady_clock::now() };
+		result.totalNanoseconds += std::chrono::duration<double, std::nano>(end - start).count();
+
+		for (std::size_t i{ 0u }; i < numberOfPairsInBatch; ++i)
+		{
+			const bool isColliding{ results[i] != 0 };
+			if (separations[i] < -touchingTolerance)
+			{
+				++result.numberOfColliding;
+				if (!isColliding)
+					++result.numberOfFalseNegatives;
+			}
+			else if (separations[i] > touchingTolerance)
+			{
+				++result.numberOfSeparate;
+				if (isColliding)
+					++result.numberOfFalsePositives;
+			}
+			else
+				++result.numberOfTouching;
+			if ((function != Function::RunTimeLevel) && (isColliding != collision::areColliding(rectangles1[i], rectangles2[i], collisionLevel)))
+				++result.numberOfDifferences;
+
+			// where the test finishes: level 0 is certain if the bounding boxes do not intersect and level 1 is certain if it finds a corner inside
+			// (areCollidingAtLevel is also certain at level 0 at level 2 if both rectangles are axis-aligned and areCollidingAxisAligned always finishes at level 0)
+			if ((collisionLevel == 0) || (function == Function::DeclaredAxisAligned) || !collision::areColliding(rectangles1[i], rectangles2[i], 0) ||
+				((function == Function::CompileTimeLevel) && (collisionLevel == 2) && isAxisAligned(rectangles1[i]) && isAxisAligned(rectangles2[i])))
+				++result.numberOfExits[0u];
+			else if ((collisionLevel == 1) || collision::areColliding(rectangles1[i], rectangles2[i], 1))
+				++result.numberOfExits[1u];
+			else
+				++result.numberOfExits[2u];
+		}
+	}
+	result.numberOfPairs = numberOfPairs;
+	return result;
+}
+
+// the number of rectangles (of the category) whose SIMD and scalar results differ when tested against a set of rectangles (of the same category)
+// each rectangle is paired (as createPair) with the rectangle at the same index in the set so touching pairs are included
+std::size_t compareProxySet(const Category category, const int collisionLevel, const unsigned int seed)
+{
+	std::mt19937 randomGenerator{ seed + static_cast<unsigned int>(category) };
+	std::vector<Rectangle> queries(proxySetSize);
+	collision::CollisionProxySet proxySet;
+	proxySet.reserve(proxySetSize);
+	for (auto& query : queries)
+	{
+		Rectangle rectangle;
+		createPair(query, rectangle, randomGenerator, category);
+		proxySet.add(rectangle);
+	}
+
+	std::size_t numberOfMismatches{ 0u };
+	std::vector<std::size_t> indices;
+	std::vector<std::size_t> scalarIndices;
+	for (const auto& query : queries)
+	{
+		const collision::CollisionProxy proxy(query);
+		proxySet.findCollisions(proxy, indices, collisionLevel);
+		proxySet.findCollisionsScalar(proxy, scalarIndices, collisionLevel);
+		if (indices != scalarIndices)
+			++numberOfMismatches;
+	}
+	return numberOfMismatches;
+}
+
+// the number of picking queries whose results differ between a range of rectangles and a range of pointers to the same rectangles
+std::size_t comparePicking(const unsigned int seed)
+{
+	std::mt19937 randomGenerator{ seed };
+	std::vector<Rectangle> rectangles(pickingSize);
+	std::vector<Rectangle*> pointers(pickingSize);
+	for (std::size_t i{ 0u }; i < pickingSize; ++i)
+	{
+		randomiseRectangle(rectangles[i], randomGenerator, Category::Random);
+		pointers[i] = &rectangles[i];
+	}
+
+	std::uniform_real_distribution<float> coordinate(-20.f, 220.f);
+	std::uniform_real_distribution<float> size(0.f, 50.f);
+	std::size_t numberOfMismatches{ 0u };
+	std::vector<std::size_t> indices;
+	std::vector<std::size_t> pointerIndices;
+	for (std::size_t i{ 0u }; i < pickingSize; ++i)
+	{
+		const sf::Vector2f point{ coordinate(randomGenerator), coordinate(randomGenerator) };
+		collision::findObjectsContainingPoint(rectangles, point, indices);
+		collision::findObjectsContainingPoint(pointers, point, pointerIndices);
+		if (indices != pointerIndices)
+			++numberOfMismatches;
+
+		const sf::FloatRect rectangle{ point, { size(randomGenerator), size(randomGenerator) } };
+		collision::findObjectsInRect(rectangles, rectangle, indices);
+		collision::findObjectsInRect(pointers, rectangle, pointerIndices);
+		if (indices != pointerIndices)
+			++numberOfMismatches;
+
+		const sf::Vector2f end{ coordinate(randomGenerator), coordinate(randomGenerator) };
+		collision::RayHit hit{};
+		collision::RayHit pointerHit{};
+		const bool isHit{ collision::findFirstHit(rectangles, point, end, hit) };
+		const bool isPointerHit{ collision::findFirstHit(pointers, point, end, pointerHit) };
+		if ((isHit != isPointerHit) || (isHit && ((hit.index != pointerHit.index) || (hit.fraction != pointerHit.fraction))))
+			++numberOfMismatches;
+	}
+	return numberOfMismatches;
+}
+
+double getRate(const std::size_t count, const std::size_t total)
+{
+	return (total == 0u) ? 0.0 : static_cast<double>(count) / total;
+}
+
+} // namespace
+
+
+
+int main(int argc, char* argv[])
+{
+	std::ofstream file;
+	if (argc > 1)
+	{
+		file.open(argv[1]);
+		if (!file)
+		{
+			std::cerr << "Unable to open " << argv[1] << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	std::ostream& output{ file.is_open() ? static_cast<std::ostream&>(file) : std::cout };
+	const std::size_t numberOfPairs{ (argc > 2) ? static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10)) : 1000000u };
+	const unsigned int seed{ (argc > 3) ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : 0u };
+
+
+
+	bool isLevel2Exact{ true };
+	bool isCompileTimeLevelIdentical{ true };
+	output << "category,level,function,pairs,ns_per_test,colliding_rate,touching_rate,false_positive_rate,false_negative_rate,exit_rate_level_0,exit_rate_level_1,exit_rate_level_2,difference_rate\n";
+	for (const Category category : { Category::Random, Category::AxisAligned, Category::Touching, Category::Degenerate })
+	{
+		for (const int collisionLevel : { 0, 1, 2 })
+		{
+			for (const Function function : { Function::RunTimeLevel, Function::CompileTimeLevel, Function::DeclaredAxisAligned })
+			{
+				if ((function == Function::DeclaredAxisAligned) && ((category != Category::AxisAligned) || (collisionLevel != 2)))
+					continue;
+				const Result result{ runTest(category, collisionLevel, function, numberOfPairs, seed) };
+				if ((collisionLevel == 2) && (category != Category::Degenerate) && ((result.numberOfFalsePositives != 0u) || (result.numberOfFalseNegatives != 0u)))
+					isLevel2Exact = false;
+				if ((function == Function::CompileTimeLevel) && (collisionLevel != 2) && (result.numberOfDifferences != 0u))
+					isCompileTimeLevelIdentical = false;
+				output << ((category == Category::Random) ? "random" : (category == Category::AxisAligned) ? "axis-aligned" : (category == Category::Touching) ? "touching" : "degenerate") << ','
+					<< collisionLevel << ','
+					<< ((function == Function::RunTimeLevel) ? "areColliding" : (function == Function::CompileTimeLevel) ? "areCollidingAtLevel" : "areCollidingAxisAligned") << ','
+					<< result.numberOfPairs << ','
+					<< (result.totalNanoseconds / result.numberOfPairs) << ','
+					<< getRate(result.numberOfColliding, result.numberOfPairs) << ','
+					<< getRate(result.numberOfTouching, result.numberOfPairs) << ','
+					<< getRate(result.numberOfFalsePositives, result.numberOfSeparate) << ','
+					<< getRate(result.numberOfFalseNegatives, result.numberOfColliding) << ','
+					<< getRate(result.numberOfExits[0u], result.numberOfPairs) << ','
+					<< getRate(result.numberOfExits[1u], result.numberOfPairs) << ','
+					<< getRate(result.numberOfExits[2u], result.numberOfPairs) << ','
+					<< getRate(result.numberOfDifferences, result.numberOfPairs) << '\n';
+				output.flush();
+			}
+		}
+	}
+
+	bool isProxySetIdentical{ true };
+	for (const Category category : { Category::Random, Category::AxisAligned, Category::Touching, Category::Degenerate })
+	{
+		for (const int collisionLevel : { 0, 1, 2 })
+		{
+			const std::size_t numberOfMismatches{ compareProxySet(category, collisionLevel, seed) };
+			if (numberOfMismatches == 0u)
+				continue;
+			isProxySetIdentical = false;
+			std::cerr << "CollisionProxySet: " << numberOfMismatches << " of " << proxySetSize << " queries differ from the scalar results ("
+				<< ((category == Category::Random) ? "random" : (category == Category::AxisAligned) ? "axis-aligned" : (category == Category::Touching) ? "touching" : "degenerate")
+				<< ", level " << collisionLevel << ")" << std::endl;
+		}
+	}
+
+	const std::size_t numberOfPickingMismatches{ comparePicking(seed) };
+	if (numberOfPickingMismatches != 0u)
+		std::cerr << "Picking: " << numberOfPickingMismatches << " of " << (pickingSize * 3u) << " queries differ between the range of rectangles and the range of pointers" << std::endl;
+
+	return (isLevel2Exact && isCompileTimeLevelIdentical && isProxySetIdentical && (numberOfPickingMismatches == 0u)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
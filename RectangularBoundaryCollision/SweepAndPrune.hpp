@@ -0,0 +1,169 @@
+#ifndef RECTANGULAR_BOUNDARY_COLLISION_SWEEP_AND_PRUNE_HPP
+#define RECTANGULAR_BOUNDARY_COLLISION_SWEEP_AND_PRUNE_HPP
+
+#include "RectangularBoundaryCollision.hpp"
+
+#include <unordered_set>
+
+namespace collision
+{
+
+// broad phase for finding all colliding pairs among many objects that move only slightly between calls (frames)
+// keeps the ends of every object's axis-aligned bounding box (level 0) sorted along each axis from one call to the next
+//     these are re-sorted with an insertion sort, which only has to do work for the ends that have passed each other since the previous call
+//     two objects' bounding boxes can only start or stop intersecting when the ends of their boxes pass each other so only those pairs are updated
+// the pairs whose bounding boxes intersect are kept (and updated) between calls; only these pairs are tested further (levels 1 and 2)
+// objects must be the same objects (in the same order) each call for the sorted ends to be reused
+//     if the number of objects changes (or reset is called), everything is rebuilt
+// objects can be any random-access range of objects (or of pointers to objects) that can be tested with areColliding
+class SweepAndPrune
+{
+public:
+	// collisions are the indices (into objects) of each colliding pair, sorted by first and then by second
+	// collision level is the same as for areColliding
+	template <class ObjectRange>
+	void findCollisions(const ObjectRange& objects, std::vector<Pair>& collisions, const int collisionLevel = -1)
+	{
+		collisions.clear();
+		const std::size_t numberOfObjects{ static_cast<std::size_t>(std::size(objects)) };
+		m_proxies.resize(numberOfObjects);
+		for (std::size_t i{ 0u }; i < numberOfObjects; ++i)
+			m_proxies[i].update(impl::getObject(objects[i]));
+
+		m_numberOfSwaps = 0u;
+		if (numberOfObjects != m_numberOfObjects)
+			rebuild(numberOfObjects);
+		else
+		{
+			updateAxis(m_xEndpoints, [](const sf::FloatRect& bounds) { return bounds.position.x; }, [](const sf::FloatRect& bounds) { return bounds.position.x + bounds.size.x; });
+			updateAxis(m_yEndpoints, [](const sf::FloatRect& bounds) { return bounds.position.y; }, [](const sf::FloatRect& bounds) { return bounds.position.y + bounds.size.y; });
+		}
+
+		for (const std::uint64_t pairKey : m_intersectingPairs)
+		{
+			const std::size_t i{ static_cast<std::size_t>(pairKey >> 32u) };
+			const std::size_t j{ static_cast<std::size_t>(pairKey & 0xFFFFFFFFu) };
+			if ((collisionLevel == 0) || impl::areCollidingBeyondLevel0(m_proxies[i], m_proxies[j], collisionLevel))
+				collisions.push_back({ i, j });
+		}
+		std::sort(collisions.begin(), collisions.end(), [](const Pair& a, const Pair& b) { return (a.first < b.first) || ((a.first == b.first) && (a.second < b.second)); });
+	}
+	// forces everything to be rebuilt by the next call to findCollisions (e.g. when the objects are replaced by others)
+	void reset()
+	{
+		m_numberOfObjects = 0u;
+		m_xEndpoints.clear();
+		m_yEndpoints.clear();
+		m_intersectingPairs.clear();
+	}
+	// number of pairs (from the most recent findCollisions) whose bounding boxes intersect, i.e. the pairs that were tested further
+	std::size_t getNumberOfCandidatePairs() const
+	{
+		return m_intersectingPairs.size();
+	}
+	// number of times (in the most recent findCollisions) that the minimum end of one object's bounding box passed the maximum end of another
+	std::size_t getNumberOfSwaps() const
+	{
+		return m_numberOfSwaps;
+	}
+
+private:
+	// one end of an object's bounding box along one axis
+	// ends with the same value are ordered with maximum ends first so that boxes that only touch do not intersect
+	struct Endpoint
+	{
+		float value;
+		std::uint32_t objectIndex;
+		bool isMaximum;
+
+		bool operator<(const Endpoint& other) const
+		{
+			return (value < other.value) || ((value == other.value) && isMaximum && !other.isMaximum);
+		}
+	};
+
+	std::size_t m_numberOfObjects{ 0u };
+	std::vector<CollisionProxy> m_proxies{};
+	std::vector<Endpoint> m_xEndpoints{};
+	std::vector<Endpoint> m_yEndpoints{};
+	std::unordered_set<std::uint64_t> m_intersectingPairs{}; // (first << 32) | second
+	std::vector<std::uint32_t> m_order{};
+	std::size_t m_numberOfSwaps{ 0u };
+
+	static std::uint64_t getPairKey(const std::uint32_t objectIndex1, const std::uint32_t objectIndex2)
+	{
+		return (objectIndex1 < objectIndex2) ? ((static_cast<std::uint64_t>(objectIndex1) << 32u) | objectIndex2) : ((static_cast<std::uint64_t>(objectIndex2) << 32u) | objectIndex1);
+	}
+
+	void rebuild(const std::size_t numberOfObjects)
+	{
+		m_numberOfObjects = numberOfObjects;
+		m_xEndpoints.resize(numberOfObjects * 2u);
+		m_yEndpoints.resize(numberOfObjects * 2u);
+		m_intersectingPairs.clear();
+		for (std::uint32_t i{ 0u }; i < numberOfObjects; ++i)
+		{
+			const sf::FloatRect& bounds{ m_proxies[i].bounds };
+			m_xEndpoints[i * 2u] = { bounds.position.x, i, false };
+			m_xEndpoints[(i * 2u) + 1u] = { bounds.position.x + bounds.size.x, i, true };
+			m_yEndpoints[i * 2u] = { bounds.position.y, i, false };
+			m_yEndpoints[(i * 2u) + 1u] = { bounds.position.y + bounds.size.y, i, true };
+		}
+		std::sort(m_xEndpoints.begin(), m_xEndpoints.end());
+		std::sort(m_yEndpoints.begin(), m_yEndpoints.end());
+
+		// single sweep along x (in order of left edges): each object is tested against the following objects whose left edges are before its right edge
+		m_order.clear();
+		for (const Endpoint& endpoint : m_xEndpoints)
+		{
+			if (!endpoint.isMaximum)
+				m_order.push_back(endpoint.objectIndex);
+		}
+		for (std::size_t a{ 0u }; a < m_order.size(); ++a)
+		{
+			const sf::FloatRect& boundsA{ m_proxies[m_order[a]].bounds };
+			const float right{ boundsA.position.x + boundsA.size.x };
+			for (std::size_t b{ a + 1u }; (b < m_order.size()) && (m_proxies[m_order[b]].bounds.position.x < right); ++b)
+			{
+				if (impl::areBoundsIntersecting(boundsA, m_proxies[m_order[b]].bounds))
+					m_intersectingPairs.insert(getPairKey(m_order[a], m_order[b]));
+			}
+		}
+	}
+	template <class GetMinimum, class GetMaximum>
+	void updateAxis(std::vector<Endpoint>& endpoints, const GetMinimum getMinimum, const GetMaximum getMaximum)
+	{
+		for (Endpoint& endpoint : endpoints)
+			endpoint.value = endpoint.isMaximum ? getMaximum(m_proxies[endpoint.objectIndex].bounds) : getMinimum(m_proxies[endpoint.objectIndex].bounds);
+
+		// insertion sort
+		// a minimum end passing a maximum end (of another object) is the only way for two boxes to start or stop intersecting along this axis
+		for (std::size_t i{ 1u }; i < endpoints.size(); ++i)
+		{
+			const Endpoint endpoint{ endpoints[i] };
+			std::size_t j{ i };
+			for (; (j > 0u) && (endpoint < endpoints[j - 1u]); --j)
+			{
+				const Endpoint& other{ endpoints[j - 1u] };
+				if ((endpoint.isMaximum != other.isMaximum) && (endpoint.objectIndex != other.objectIndex))
+				{
+					++m_numberOfSwaps;
+					updatePair(endpoint.objectIndex, other.objectIndex);
+				}
+				endpoints[j] = other;
+			}
+			endpoints[j] = endpoint;
+		}
+	}
+	// the pair's boxes are tested fully (both axes) since the other axis may not have been updated yet
+	void updatePair(const std::uint32_t objectIndex1, const std::uint32_t objectIndex2)
+	{
+		if (impl::areBoundsIntersecting(m_proxies[objectIndex1].bounds, m_proxies[objectIndex2].bounds))
+			m_intersectingPairs.insert(getPairKey(objectIndex1, objectIndex2));
+		else
+			m_intersectingPairs.erase(getPairKey(objectIndex1, objectIndex2));
+	}
+};
+
+} // namespace collision
+#endif // RECTANGULAR_BOUNDARY_COLLISION_SWEEP_AND_PRUNE_HPP
@@ -0,0 +1,150 @@
+#ifndef HAPAXIA_SFMLSNIPPETS_ASYNC_SPRITE_BATCHER
+#define HAPAXIA_SFMLSNIPPETS_ASYNC_SPRITE_BATCHER
+
+#include "SimpleSpriteBatcher.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// double-buffered version of the simple sprite batcher that batches on a background thread
+// batchSprites starts batching into the back buffer and returns immediately; drawing uses the front buffer (the most recently finished batch)
+// this allows the calling thread to draw (and display) the previous frame while the next one is being batched
+//     the cost is one frame of latency: what is drawn is the state of the sprites from the previous call to batchSprites
+// the sprites are read by the background thread until batching finishes so they must not be modified (or destroyed) before calling finishBatching
+//     batchSprites and setNumberOfThreads call finishBatching themselves
+// a typical frame is:
+//     finishBatching() -> update sprites -> batchSprites(sprites) -> draw
+// grouping by texture and culling behave the same as in the simple sprite batcher
+class AsyncSpriteBatcher : public sf::Drawable
+{
+public:
+	sf::Texture* texture{ nullptr };
+	AsyncSpriteBatcher()
+		: m_thread{ [this]() { work(); } }
+	{
+	}
+	~AsyncSpriteBatcher()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+	}
+	AsyncSpriteBatcher(const AsyncSpriteBatcher&) = delete;
+	AsyncSpriteBatcher& operator=(const AsyncSpriteBatcher&) = delete;
+	// sprites can be any range supported by SimpleSpriteBatcher::batchSprites
+	// the range itself is not copied so it must stay alive until batching has finished (temporary ranges are not allowed)
+	template <class SpriteRange>
+	void batchSprites(const SpriteRange& sprites)
+	{
+		finishBatching();
+		SimpleSpriteBatcher& backBatcher{ m_batchers[1u - m_frontIndex] };
+		backBatcher.texture = texture;
+		if (m_isCulling)
+			backBatcher.setVisibleRect(m_visibleRect);
+		else
+			backBatcher.clearVisibleRect();
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			m_sprites = &sprites;
+			m_batchSprites = [](SimpleSpriteBatcher& batcher, const void* spriteRange) { batcher.batchSprites(*static_cast<const SpriteRange*>(spriteRange)); };
+			m_isBatching = true;
+		}
+		m_condition.notify_all();
+	}
+	template <class SpriteRange>
+	void batchSprites(const SpriteRange&& sprites) = delete;
+	// waits for the background thread to finish batching (if it is) and then makes that batch the one that is drawn
+	// after this, the sprites can be safely modified
+	void finishBatching()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait(lock, [this]() { return !m_isBatching; });
+		if (m_sprites == nullptr)
+			return;
+		m_sprites = nullptr;
+		m_frontIndex = 1u - m_frontIndex;
+	}
+	bool isBatching() const
+	{
+		const std::lock_guard<std::mutex> lock(m_mutex);
+		return m_isBatching;
+	}
+	// these apply from the next call to batchSprites
+	void setVisibleRect(const sf::FloatRect& visibleRect)
+	{
+		m_isCulling = true;
+		m_visibleRect = visibleRect;
+	}
+	void setVisibleRect(const sf::View& view)
+	{
+		sf::Transform viewRotation;
+		viewRotation.rotate(view.getRotation(), view.getCenter());
+		setVisibleRect(viewRotation.transformRect({ view.getCenter() - (view.getSize() / 2.f), view.getSize() }));
+	}
+	void clearVisibleRect()
+	{
+		m_isCulling = false;
+	}
+	// number of threads used by the background thread to write quads (see SimpleSpriteBatcher::setNumberOfThreads)
+	void setNumberOfThreads(const std::size_t numberOfThreads)
+	{
+		finishBatching();
+		for (auto& batcher : m_batchers)
+			batcher.setNumberOfThreads(numberOfThreads);
+	}
+	std::size_t getNumberOfThreads() const
+	{
+		return m_batchers[m_frontIndex].getNumberOfThreads();
+	}
+	// these refer to the batch that is drawn (the front buffer)
+	std::size_t getNumberOfDrawCalls() const
+	{
+		return m_batchers[m_frontIndex].getNumberOfDrawCalls();
+	}
+	SimpleSpriteBatcher::Statistics getStatistics() const
+	{
+		return m_batchers[m_frontIndex].getStatistics();
+	}
+
+private:
+	SimpleSpriteBatcher m_batchers[2u]{}; // front and back buffers; only the back buffer is touched by the background thread
+	std::size_t m_frontIndex{ 0u };
+	bool m_isCulling{ false };
+	sf::FloatRect m_visibleRect{};
+	mutable std::mutex m_mutex{};
+	std::condition_variable m_condition{};
+	const void* m_sprites{ nullptr };
+	void (*m_batchSprites)(SimpleSpriteBatcher&, const void*) { nullptr };
+	bool m_isBatching{ false };
+	bool m_isStopping{ false };
+	std::thread m_thread; // last so that everything it uses is constructed first
+
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const
+	{
+		target.draw(m_batchers[m_frontIndex], states);
+	}
+
+	void work()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_condition.wait(lock, [this]() { return m_isStopping || m_isBatching; });
+			if (m_isStopping)
+				return;
+			SimpleSpriteBatcher& backBatcher{ m_batchers[1u - m_frontIndex] };
+			const void* sprites{ m_sprites };
+			const auto batchSprites{ m_batchSprites };
+			lock.unlock();
+			batchSprites(backBatcher, sprites);
+			lock.lock();
+			m_isBatching = false;
+			m_condition.notify_all();
+		}
+	}
+};
+
+#endif // HAPAXIA_SFMLSNIPPETS_ASYNC_SPRITE_BATCHER
@@ -0,0 +1,242 @@
+#ifndef HAPAXIA_SFMLSNIPPETS_CHUNKED_SPRITE_BATCHER
+#define HAPAXIA_SFMLSNIPPETS_CHUNKED_SPRITE_BATCHER
+
+#include "SimpleSpriteBatcher.hpp"
+#include <cmath>
+#include <unordered_map>
+
+// spatially chunked version of the simple sprite batcher, intended for large (mostly) static scenes
+// the world is split into a grid of chunks (cells of a fixed size) and each sprite belongs to the chunk that contains the centre of its global bounds
+// each chunk keeps its own batch (vertices) that is only rebuilt when one of its sprites is added, removed or marked dirty
+// only the chunks that overlap the render target's view are drawn so the cost of drawing depends on the size of the view, not the size of the world
+// the batcher does not own the sprites: an added sprite must stay alive (at the same address) until it is removed
+// changes (adding, removing or marking sprites dirty) are only drawn after update is called
+//     a removed sprite's chunk keeps drawing it until then (unless the chunk is left empty, in which case the chunk is removed straight away)
+// how far sprites can reach outside of their chunks (the largest sprite seen since the last removeAllSprites) only ever grows
+//     it expands the area that draw searches for visible chunks so one very large sprite makes drawing (but not the result) slower
+// chunks are drawn row by row (top to bottom, left to right); within a chunk, sprites are grouped by texture (see SimpleSpriteBatcher)
+//     overlapping sprites from different chunks are drawn in chunk order
+class ChunkedSpriteBatcher : public sf::Drawable
+{
+public:
+	explicit ChunkedSpriteBatcher(const sf::Vector2f chunkSize = { 512.f, 512.f })
+		: m_chunkSize{ chunkSize }
+	{
+	}
+	std::size_t addSprite(const sf::Sprite& sprite)
+	{
+		std::size_t spriteId{ m_entries.size() };
+		if (m_freeSpriteIds.empty())
+			m_entries.push_back({ &sprite, 0u, false, false });
+		else
+		{
+			spriteId = m_freeSpriteIds.back();
+			m_freeSpriteIds.pop_back();
+			m_entries[spriteId] = { &sprite, 0u, false, false };
+		}
+		markDirty(spriteId);
+		return spriteId;
+	}
+	void removeSprite(const std::size_t spriteId)
+	{
+		if ((spriteId >= m_entries.size()) || (m_entries[spriteId].sprite == nullptr))
+			return;
+		if (m_entries[spriteId].isInChunk)
+		{
+			const std::uint64_t chunkKey{ m_entries[spriteId].chunkKey };
+			removeFromChunk(spriteId);
+			if (m_chunks[chunkKey].spriteIds.empty())
+				m_chunks.erase(chunkKey);
+		}
+		m_entries[spriteId] = { nullptr, 0u, false, false };
+		m_freeSpriteIds.push_back(spriteId);
+	}
+	void removeAllSprites()
+	{
+		m_entries.clear();
+		m_freeSpriteIds.clear();
+		m_dirtySpriteIds.clear();
+		m_chunks.clear();
+		m_maximumSpriteExtent = 0.f;
+	}
+	// call this whenever a sprite's transform, colour, texture or texture rect has changed
+	void markDirty(const std::size_t spriteId)
+	{
+		if ((spriteId >= m_entries.size()) || (m_entries[spriteId].sprite == nullptr) || (m_entries[spriteId].isDirty))
+			return;
+		m_entries[spriteId].isDirty = true;
+		m_dirtySpriteIds.push_back(spriteId);
+	}
+	void markAllDirty()
+	{
+		for (std::size_t i{ 0u }; i < m_entries.size(); ++i)
+			markDirty(i);
+	}
+	// moves dirty sprites to their (new) chunks and rebuilds only the chunks that have changed
+	void update()
+	{
+		for (auto& spriteId : m_dirtySpriteIds)
+		{
+			Entry& entry{ m_entries[spriteId] };
+			entry.isDirty = false;
+			if (entry.sprite == nullptr)
+				continue;
+
+			const sf::FloatRect bounds{ entry.sprite->getGlobalBounds() };
+			m_maximumSpriteExtent = std::max(m_maximumSpriteExtent, std::max(bounds.size.x, bounds.size.y) / 2.f);
+			const std::uint64_t chunkKey{ getChunkKey(getChunkCoord(bounds.getCenter())) };
+			if (entry.isInChunk && (entry.chunkKey == chunkKey))
+			{
+				m_chunks[chunkKey].needsRebuild = true;
+				continue;
+			}
+			if (entry.isInChunk)
+				removeFromChunk(spriteId);
+			Chunk& chunk{ m_chunks[chunkKey] };
+			chunk.spriteIds.push_back(spriteId);
+			chunk.needsRebuild = true;
+			entry.chunkKey = chunkKey;
+			entry.isInChunk = true;
+		}
+		m_dirtySpriteIds.clear();
+
+		for (auto it{ m_chunks.begin() }; it != m_chunks.end();)
+		{
+			Chunk& chunk{ it->second };
+			if (chunk.spriteIds.empty())
+			{
+				it = m_chunks.erase(it);
+				continue;
+			}
+			if (chunk.needsRebuild)
+				rebuildChunk(chunk);
+			++it;
+		}
+	}
+	sf::Vector2f getChunkSize() const
+	{
+		return m_chunkSize;
+	}
+	std::size_t getNumberOfSprites() const
+	{
+		return m_entries.size() - m_freeSpriteIds.size();
+	}
+	std::size_t getNumberOfChunks() const
+	{
+		return m_chunks.size();
+	}
+	// statistics of the most recent draw
+	std::size_t getNumberOfDrawnChunks() const
+	{
+		return m_numberOfDrawnChunks;
+	}
+	std::size_t getNumberOfDrawCalls() const
+	{
+		return m_numberOfDrawCalls;
+	}
+
+private:
+	struct Entry
+	{
+		const sf::Sprite* sprite;
+		std::uint64_t chunkKey;
+		bool isInChunk;
+		bool isDirty;
+	};
+	struct Chunk
+	{
+		std::vector<std::size_t> spriteIds{};
+		SimpleSpriteBatcher batcher{};
+		sf::FloatRect bounds{}; // union of the chunk's sprites' global bounds
+		bool needsRebuild{ true };
+	};
+
+	sf::Vector2f m_chunkSize;
+	std::vector<Entry> m_entries{};
+	std::vector<std::size_t> m_freeSpriteIds{};
+	std::vector<std::size_t> m_dirtySpriteIds{};
+	std::unordered_map<std::uint64_t, Chunk> m_chunks{};
+	float m_maximumSpriteExtent{ 0.f }; // how far (at most) a sprite can reach outside of its chunk
+	mutable std::vector<std::pair<std::uint64_t, const Chunk*>> m_visibleChunks{};
+	mutable std::size_t m_numberOfDrawnChunks{ 0u };
+	mutable std::size_t m_numberOfDrawCalls{ 0u };
+
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const
+	{
+		const sf::View& view{ target.getView() };
+		sf::Transform viewRotation;
+		viewRotation.rotate(view.getRotation(), view.getCenter());
+		const sf::FloatRect visibleRect{ viewRotation.transformRect({ view.getCenter() - (view.getSize() / 2.f), view.getSize() }) };
+
+		// visit the cells that overlap the view (expanded by how far sprites can reach outside of their chunks) unless there are more of those than there are chunks
+		m_visibleChunks.clear();
+		const sf::Vector2f maximumSpriteExtent{ m_maximumSpriteExtent, m_maximumSpriteExtent };
+		const sf::Vector2i firstCell{ getChunkCoord(visibleRect.position - maximumSpriteExtent) };
+		const sf::Vector2i lastCell{ getChunkCoord(visibleRect.position + visibleRect.size + maximumSpriteExtent) };
+		const double numberOfCells{ (static_cast<double>(lastCell.x) - firstCell.x + 1.0) * (static_cast<double>(lastCell.y) - firstCell.y + 1.0) };
+		if (numberOfCells <= static_cast<double>(m_chunks.size()))
+		{
+			for (int y{ firstCell.y }; y <= lastCell.y; ++y)
+			{
+				for (int x{ firstCell.x }; x <= lastCell.x; ++x)
+				{
+					const std::uint64_t chunkKey{ getChunkKey({ x, y }) };
+					const auto it{ m_chunks.find(chunkKey) };
+					if ((it != m_chunks.end()) && it->second.bounds.findIntersection(visibleRect))
+						m_visibleChunks.push_back({ chunkKey, &(it->second) });
+				}
+			}
+		}
+		else
+		{
+			for (auto& chunk : m_chunks)
+			{
+				if (chunk.second.bounds.findIntersection(visibleRect))
+					m_visibleChunks.push_back({ chunk.first, &(chunk.second) });
+			}
+			// keys sort in row order (y first, then x)
+			std::sort(m_visibleChunks.begin(), m_visibleChunks.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+		}
+
+		m_numberOfDrawnChunks = m_visibleChunks.size();
+		m_numberOfDrawCalls = 0u;
+		for (auto& visibleChunk : m_visibleChunks)
+		{
+			target.draw(visibleChunk.second->batcher, states);
+			m_numberOfDrawCalls += visibleChunk.second->batcher.getNumberOfDrawCalls();
+		}
+	}
+
+	sf::Vector2i getChunkCoord(const sf::Vector2f position) const
+	{
+		return { static_cast<int>(std::floor(position.x / m_chunkSize.x)), static_cast<int>(std::floor(position.y / m_chunkSize.y)) };
+	}
+	// coordinates are offset so that the keys order by y and then by x
+	static std::uint64_t getChunkKey(const sf::Vector2i chunkCoord)
+	{
+		return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkCoord.y) ^ 0x80000000u) << 32u) | (static_cast<std::uint32_t>(chunkCoord.x) ^ 0x80000000u);
+	}
+	void removeFromChunk(const std::size_t spriteId)
+	{
+		Entry& entry{ m_entries[spriteId] };
+		Chunk& chunk{ m_chunks[entry.chunkKey] };
+		chunk.spriteIds.erase(std::find(chunk.spriteIds.begin(), chunk.spriteIds.end(), spriteId));
+		chunk.needsRebuild = true;
+		entry.isInChunk = false;
+	}
+	void rebuildChunk(Chunk& chunk)
+	{
+		chunk.batcher.batchSprites(chunk.spriteIds, [this](const std::size_t spriteId) { return m_entries[spriteId].sprite; });
+		chunk.bounds = m_entries[chunk.spriteIds.front()].sprite->getGlobalBounds();
+		for (auto& spriteId : chunk.spriteIds)
+		{
+			const sf::FloatRect bounds{ m_entries[spriteId].sprite->getGlobalBounds() };
+			const sf::Vector2f topLeft{ std::min(chunk.bounds.position.x, bounds.position.x), std::min(chunk.bounds.position.y, bounds.position.y) };
+			const sf::Vector2f bottomRight{ std::max(chunk.bounds.position.x + chunk.bounds.size.x, bounds.position.x + bounds.size.x), std::max(chunk.bounds.position.y + chunk.bounds.size.y, bounds.position.y + bounds.size.y) };
+			chunk.bounds = { topLeft, bottomRight - topLeft };
+		}
+		chunk.needsRebuild = false;
+	}
+};
+
+#endif // HAPAXIA_SFMLSNIPPETS_CHUNKED_SPRITE_BATCHER
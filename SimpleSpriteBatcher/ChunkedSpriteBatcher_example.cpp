@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023-2026 M.J.Silk
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//
+//       ------------
+//       INTRODUCTION
+//       ------------
+//
+//   Creates a large vector of sprites spread over a world that is much larger than the window (twenty times its width and height).
+//   They are (trivially) randomly placed, scaled and rotated. They do not move.
+//   The view can be scrolled around the world using the arrow keys.
+//   The sprites can be drawn in one of two ways (toggled by pressing SPACE):
+//     - batched using the simple sprite batcher with culling (all sprites are culled and the visible ones re-batched every frame)
+//     - batched using the chunked sprite batcher (sprites are batched once per chunk and only the chunks that overlap the view are drawn)
+//   The window title shows the number of chunks that are drawn when using the chunked sprite batcher.
+//
+//
+//       --------
+//       CONTROLS
+//       --------
+//
+//   ARROWS                 scroll view
+//   SPACE			        toggle drawing method (starts with simple sprite batcher)
+//   ESC                    quit
+// 
+// 
+//       -------------
+//       CUSTOMISATION
+//       -------------
+//
+//   You can (should) change the number of sprites ('n') created (but not too many!) so that they lower your frame-rate using this line: sprites.resize('n', sf::Sprite(texture));
+//   You can change the size of the chunks using this line: ChunkedSpriteBatcher chunkedBatcher({ 512.f, 512.f });
+//
+//
+//        ----
+//        NOTE
+//        ----
+//
+//    If the window is too large (1920u, 1080u) for your resolution, you can uncomment the following define line to halve the window size (to 960x540): #define HALVE_WINDOW_SIZE
+//    The texture is available in the resources folder, which is in the root folder. You may need to adjust the path.
+//    You may also need to adjust the path of the included headers ("SimpleSpriteBatcher.hpp" and "ChunkedSpriteBatcher.hpp") depending on your approach.
+//    Remember to test in both debug and release modes for comparisons. The batchers may be less effective in debug mode.
+// 
+//    This example is for use with SFML 3.
+//
+//
+////////////////////////////////////////////////////////////////
+
+
+
+#include <SFML/Graphics.hpp>
+
+#include "../SimpleSpriteBatcher/SimpleSpriteBatcher.hpp"
+#include "../SimpleSpriteBatcher/ChunkedSpriteBatcher.hpp"
+
+
+
+//#define HALVE_WINDOW_SIZE
+
+
+
+int main()
+{
+	sf::Vector2u windowSize{ 1920u, 1080u };
+#ifdef HALVE_WINDOW_SIZE
+	windowSize /= 2u;
+#endif // HALVE_WINDOW_SIZE
+	const sf::Vector2u worldSize{ windowSize * 20u };
+
+
+
+	// texture
+	sf::Texture texture;
+	if (!texture.loadFromFile("resources/images/16colours(16x16_4x4each)-tex.png"))
+		return EXIT_FAILURE;
+
+
+
+	// sprites
+	std::vector<sf::Sprite> sprites;
+	sprites.resize(1000000u, sf::Sprite(texture)); // change this to a value that is affects your frame-rate. this will be different on every system.
+	for (auto& sprite : sprites)
+	{
+		const std::size_t randomTileIndex{ rand() % 16u };
+		sprite.setTextureRect({ { (static_cast<int>(randomTileIndex) % 4) * 4, (static_cast<int>(randomTileIndex) / 4) * 4 }, { 4, 4 } });
+		const float scale{ ((rand() % 950) + 50) / 100.f };
+		sprite.setScale({ scale , scale });
+		sprite.setPosition({ static_cast<float>(rand() % worldSize.x), static_cast<float>(rand() % worldSize.y) });
+		sprite.setRotation(sf::degrees((rand() % 1000) * 0.36f));
+	}
+
+
+
+	// batchers
+	SimpleSpriteBatcher simpleBatcher;
+	ChunkedSpriteBatcher chunkedBatcher({ 512.f, 512.f });
+	for (auto& sprite : sprites)
+		chunkedBatcher.addSprite(sprite);
+	chunkedBatcher.update(); // sprites never change so this is the only update needed
+
+
+
+	// drawing method. this can be toggled by pressing SPACE
+	enum class Method
+	{
+		Simple,
+		Chunked,
+	} method{ Method::Simple };
+
+
+
+	constexpr float scrollSpeed{ 1000.f }; // pixels per second
+	sf::Clock clock; // clock for measuring FPS (and scrolling)
+	sf::RenderWindow window(sf::VideoMode(windowSize), "");
+	sf::View view{ window.getDefaultView() };
+	while (window.isOpen())
+	{
+		const float frameTime{ clock.restart().asSeconds() };
+
+		// scroll view
+		sf::Vector2f scroll{ 0.f, 0.f };
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left))
+			scroll.x -= 1.f;
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right))
+			scroll.x += 1.f;
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up))
+			scroll.y -= 1.f;
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down))
+			scroll.y += 1.f;
+		view.move(scroll * scrollSpeed * frameTime);
+		window.setView(view);
+
+		// batch sprites (the chunked batcher does not need re-batching since its sprites do not change)
+		if (method == Method::Simple)
+		{
+			simpleBatcher.setVisibleRect(view);
+			simpleBatcher.batchSprites(sprites);
+		}
+
+		// render
+		window.clear();
+		if (method == Method::Simple)
+			window.draw(simpleBatcher);
+		else
+			window.draw(chunkedBatcher);
+		window.display();
+
+		// show trivial FPS in window title
+		const std::string methodName{ (method == Method::Simple) ? "SIMPLE (CULLED):     " : "CHUNKED (" + std::to_string(chunkedBatcher.getNumberOfDrawnChunks()) + " chunks):     " };
+		window.setTitle(methodName + std::to_string(static_cast<int>(1.f / frameTime)) + "\tFPS");
+
+		// events
+		while (const auto event{ window.pollEvent() })
+		{
+			if (event->is<sf::Event::Closed>())
+				window.close();
+			else if (const auto keyPressed{ event->getIf<sf::Event::KeyPressed>() })
+			{
+				switch (keyPressed->code)
+				{
+				case sf::Keyboard::Key::Escape:
+					window.close();
+					break;
+				case sf::Keyboard::Key::Space:
+					method = (method == Method::Simple) ? Method::Chunked : Method::Simple;
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,317 @@
+#ifndef HAPAXIA_SFMLSNIPPETS_MIXED_BATCHER
+#define HAPAXIA_SFMLSNIPPETS_MIXED_BATCHER
+
+#include "SimpleSpriteBatcher.hpp"
+#include <cmath>
+
+// batcher for a mix of sprites, texts and shapes
+// each added item is converted to triangles straight away (with its transform applied) so it can be changed (or destroyed) once added
+//     sprites are quads, texts are a quad for each glyph (and line) using the font's page texture and shapes are their (triangulated) fill and outline
+// items are grouped by texture in the same way as in the simple sprite batcher: each group is drawn with a single draw call
+//     groups are drawn in the order their textures first appear and items keep their order within their group
+//     untextured shapes (and all shape outlines) are a group of their own
+//     optionally, each item can be given a draw order (layer and depth; see simpleSpriteBatcher::DrawOrder) to control the order
+// texts are created in the same way as sf::Text (including style, spacing and outline)
+// shapes are triangulated as fans so should be convex (as sf::Shape requires)
+// a typical frame is:
+//     clear() -> add items -> batch() -> draw
+class MixedBatcher : public sf::Drawable
+{
+public:
+	MixedBatcher() = default;
+	void clear()
+	{
+		m_items.clear();
+		m_stagingVertices.clear();
+		m_batches.clear();
+	}
+	void add(const sf::Sprite& sprite, const simpleSpriteBatcher::DrawOrder drawOrder = {})
+	{
+		const std::size_t startVertex{ m_stagingVertices.size() };
+		m_stagingVertices.resize(startVertex + 6u);
+		simpleSpriteBatcher::impl::setQuad(m_stagingVertices.data() + startVertex, sprite);
+		addItem(&(sprite.getTexture()), startVertex, drawOrder);
+	}
+	void add(const sf::Text& text, const simpleSpriteBatcher::DrawOrder drawOrder = {})
+	{
+		const std::size_t startVertex{ m_stagingVertices.size() };
+		if (text.getOutlineThickness() != 0.f)
+			addTextVertices(text, true);
+		addTextVertices(text, false);
+		const sf::Transform transform{ text.getTransform() };
+		for (std::size_t i{ startVertex }; i < m_stagingVertices.size(); ++i)
+			m_stagingVertices[i].position = transform.transformPoint(m_stagingVertices[i].position);
+		if (m_stagingVertices.size() != startVertex)
+			addItem(&(text.getFont().getTexture(text.getCharacterSize())), startVertex, drawOrder);
+	}
+	void add(const sf::Shape& shape, const simpleSpriteBatcher::DrawOrder drawOrder = {})
+	{
+		const std::size_t numberOfPoints{ shape.getPointCount() };
+		if (numberOfPoints < 3u)
+			return;
+		const sf::Transform transform{ shape.getTransform() };
+
+		// fill (a fan around the centre of the bounds of the shape's points, as sf::Shape; its local bounds would also include the outline)
+		sf::Vector2f topLeft{ shape.getPoint(0u) };
+		sf::Vector2f bottomRight{ topLeft };
+		for (std::size_t i{ 1u }; i < numberOfPoints; ++i)
+		{
+			const sf::Vector2f point{ shape.getPoint(i) };
+			topLeft = { std::min(topLeft.x, point.x), std::min(topLeft.y, point.y) };
+			bottomRight = { std::max(bottomRight.x, point.x), std::max(bottomRight.y, point.y) };
+		}
+		const sf::FloatRect bounds{ topLeft, bottomRight - topLeft };
+		const sf::Vector2f centre{ bounds.getCenter() };
+		const sf::IntRect textureRect{ shape.getTextureRect() };
+		const auto getTexCoords{ [&bounds, &textureRect](const sf::Vector2f point)
+		{
+			const float xRatio{ (bounds.size.x > 0.f) ? ((point.x - bounds.position.x) / bounds.size.x) : 0.f };
+			const float yRatio{ (bounds.size.y > 0.f) ? ((point.y - bounds.position.y) / bounds.size.y) : 0.f };
+			return sf::Vector2f{ textureRect.position.x + (textureRect.size.x * xRatio), textureRect.position.y + (textureRect.size.y * yRatio) };
+		} };
+		const sf::Color fillColor{ shape.getFillColor() };
+		const sf::Vertex centreVertex{ transform.transformPoint(centre), fillColor, getTexCoords(centre) };
+		std::size_t startVertex{ m_stagingVertices.size() };
+		for (std::size_t i{ 0u }; i < numberOfPoints; ++i)
+		{
+			const sf::Vector2f point{ shape.getPoint(i) };
+			const sf::Vector2f nextPoint{ shape.getPoint((i + 1u) % numberOfPoints) };
+			m_stagingVertices.push_back(centreVertex);
+			m_stagingVertices.push_back({ transform.transformPoint(point), fillColor, getTexCoords(point) });
+			m_stagingVertices.push_back({ transform.transformPoint(nextPoint), fillColor, getTexCoords(nextPoint) });
+		}
+		addItem(shape.getTexture(), startVertex, drawOrder);
+
+		// outline (a strip of quads around the shape; never textured)
+		const float outlineThickness{ shape.getOutlineThickness() };
+		if (outlineThickness == 0.f)
+			return;
+		const sf::Color outlineColor{ shape.getOutlineColor() };
+		startVertex = m_stagingVertices.size();
+		sf::Vector2f previousInner{};
+		sf::Vector2f previousOuter{};
+		for (std::size_t i{ 0u }; i <= numberOfPoints; ++i)
+		{
+			const sf::Vector2f p0{ shape.getPoint((i + numberOfPoints - 1u) % numberOfPoints) };
+			const sf::Vector2f p1{ shape.getPoint(i % numberOfPoints) };
+			const sf::Vector2f p2{ shape.getPoint((i + 1u) % numberOfPoints) };
+
+			// normals point away from the centre
+			sf::Vector2f normal1{ computeNormal(p0, p1) };
+			sf::Vector2f normal2{ computeNormal(p1, p2) };
+			if (normal1.dot(centre - p1) > 0.f)
+				normal1 = -normal1;
+			if (normal2.dot(centre - p1) > 0.f)
+				normal2 = -normal2;
+			const float factor{ 1.f + normal1.dot(normal2) };
+			const sf::Vector2f normal{ (factor == 0.f) ? normal1 : ((normal1 + normal2) / factor) };
+
+			const sf::Vector2f inner{ transform.transformPoint(p1) };
+			const sf::Vector2f outer{ transform.transformPoint(p1 + (normal * outlineThickness)) };
+			if (i > 0u)
+			{
+				m_stagingVertices.push_back({ previousInner, outlineColor });
+				m_stagingVertices.push_back({ previousOuter, outlineColor });
+				m_stagingVertices.push_back({ inner, outlineColor });
+				m_stagingVertices.push_back({ inner, outlineColor });
+				m_stagingVertices.push_back({ previousOuter, outlineColor });
+				m_stagingVertices.push_back({ outer, outlineColor });
+			}
+			previousInner = inner;
+			previousOuter = outer;
+		}
+		addItem(nullptr, startVertex, drawOrder);
+	}
+	// sorts the added items into batches; call this after adding all of the items and before drawing
+	void batch()
+	{
+		m_batches.clear();
+		const std::size_t numberOfItems{ m_items.size() };
+		if (numberOfItems == 0u)
+			return;
+
+		simpleSpriteBatcher::impl::sortByDrawOrder(numberOfItems, [this](const std::size_t i) { return m_items[i].texture; }, [this](const std::size_t i) { return m_items[i].drawOrder; }, m_textures, m_sortItems, m_sortItemsBuffer);
+		m_isInputOrder = true;
+		for (std::size_t i{ 0u }; (i < numberOfItems) && m_isInputOrder; ++i)
+			m_isInputOrder = (m_sortItems[i].index == i);
+
+		// items that are already in order are drawn straight from the staging vertices; otherwise, they are copied in their sorted order
+		if (!m_isInputOrder && (m_vertices.size() < m_stagingVertices.size()))
+			m_vertices.resize(m_stagingVertices.size());
+		std::size_t vertexIndex{ 0u };
+		for (auto& sortItem : m_sortItems)
+		{
+			const Item& item{ m_items[sortItem.index] };
+			const std::size_t startVertex{ m_isInputOrder ? item.startVertex : vertexIndex };
+			if (!m_isInputOrder)
+				std::copy(m_stagingVertices.begin() + static_cast<std::ptrdiff_t>(item.startVertex), m_stagingVertices.begin() + static_cast<std::ptrdiff_t>(item.startVertex + item.numberOfVertices), m_vertices.begin() + static_cast<std::ptrdiff_t>(vertexIndex));
+			vertexIndex += item.numberOfVertices;
+
+			if (m_batches.empty() || (m_batches.back().texture != item.texture))
+				m_batches.push_back({ item.texture, startVertex, 0u });
+			m_batches.back().numberOfVertices += item.numberOfVertices;
+		}
+	}
+	std::size_t getNumberOfItems() const
+	{
+		return m_items.size();
+	}
+	std::size_t getNumberOfVertices() const
+	{
+		return m_stagingVertices.size();
+	}
+	std::size_t getNumberOfDrawCalls() const
+	{
+		return m_batches.size();
+	}
+
+private:
+	struct Item
+	{
+		const sf::Texture* texture;
+		std::size_t startVertex;
+		std::size_t numberOfVertices;
+		simpleSpriteBatcher::DrawOrder drawOrder;
+	};
+	struct Batch
+	{
+		const sf::Texture* texture;
+		std::size_t startVertex;
+		std::size_t numberOfVertices;
+	};
+
+	std::vector<Item> m_items{};
+	std::vector<sf::Vertex> m_stagingVertices{}; // vertices of the items in the order they were added
+	std::vector<sf::Vertex> m_vertices{}; // vertices of the items in their sorted order (only used if that is different)
+	std::vector<Batch> m_batches{};
+	std::vector<const sf::Texture*> m_textures{};
+	std::vector<simpleSpriteBatcher::impl::SortItem> m_sortItems{};
+	std::vector<simpleSpriteBatcher::impl::SortItem> m_sortItemsBuffer{};
+	bool m_isInputOrder{ true };
+
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const
+	{
+		const sf::Vertex* vertices{ m_isInputOrder ? m_stagingVertices.data() : m_vertices.data() };
+		for (auto& batch : m_batches)
+		{
+			states.texture = batch.texture;
+			target.draw(vertices + batch.startVertex, batch.numberOfVertices, sf::PrimitiveType::Triangles, states);
+		}
+	}
+
+	void addItem(const sf::Texture* texture, const std::size_t startVertex, const simpleSpriteBatcher::DrawOrder drawOrder)
+	{
+		m_items.push_back({ texture, startVertex, m_stagingVertices.size() - startVertex, drawOrder });
+	}
+
+	static sf::Vector2f computeNormal(const sf::Vector2f p1, const sf::Vector2f p2)
+	{
+		const sf::Vector2f normal{ p1.y - p2.y, p2.x - p1.x };
+		const float length{ normal.length() };
+		return (length == 0.f) ? normal : (normal / length);
+	}
+
+	// text geometry (matches sf::Text)
+	// vertices are in the text's local coordinates
+	void addTextVertices(const sf::Text& text, const bool isOutline)
+	{
+		const sf::Font& font{ text.getFont() };
+		const sf::String& string{ text.getString() };
+		const unsigned int characterSize{ text.getCharacterSize() };
+		const std::uint32_t style{ text.getStyle() };
+		const bool isBold{ (style & sf::Text::Bold) != 0u };
+		const bool isUnderlined{ (style & sf::Text::Underlined) != 0u };
+		const bool isStrikeThrough{ (style & sf::Text::StrikeThrough) != 0u };
+		const float italicShear{ ((style & sf::Text::Italic) != 0u) ? sf::degrees(12.f).asRadians() : 0.f };
+		const float outlineThickness{ isOutline ? text.getOutlineThickness() : 0.f };
+		const sf::Color color{ isOutline ? text.getOutlineColor() : text.getFillColor() };
+
+		const float underlineOffset{ font.getUnderlinePosition(characterSize) };
+		const float underlineThickness{ font.getUnderlineThickness(characterSize) };
+		const sf::FloatRect xBounds{ font.getGlyph(U'x', characterSize, isBold).bounds };
+		const float strikeThroughOffset{ xBounds.position.y + (xBounds.size.y / 2.f) };
+
+		float whitespaceWidth{ font.getGlyph(U' ', characterSize, isBold).advance };
+		const float letterSpacing{ (whitespaceWidth / 3.f) * (text.getLetterSpacing() - 1.f) };
+		whitespaceWidth += letterSpacing;
+		const float lineSpacing{ font.getLineSpacing(characterSize) * text.getLineSpacing() };
+
+		float x{ 0.f };
+		float y{ static_cast<float>(characterSize) };
+		std::uint32_t previousCharacter{ 0u };
+		const auto addLines{ [&]()
+		{
+			if (isUnderlined)
+				addTextLine(x, y, color, underlineOffset, underlineThickness, outlineThickness);
+			if (isStrikeThrough)
+				addTextLine(x, y, color, strikeThroughOffset, underlineThickness, outlineThickness);
+		} };
+		for (const std::uint32_t character : string)
+		{
+			if (character == U'\r')
+				continue;
+
+			x += font.getKerning(previousCharacter, character, characterSize, isBold);
+			if ((character == U'\n') && (previousCharacter != U'\n'))
+				addLines();
+			previousCharacter = character;
+
+			switch (character)
+			{
+			case U' ':
+				x += whitespaceWidth;
+				continue;
+			case U'\t':
+				x += whitespaceWidth * 4.f;
+				continue;
+			case U'\n':
+				y += lineSpacing;
+				x = 0.f;
+				continue;
+			}
+
+			const sf::Glyph& glyph{ font.getGlyph(character, characterSize, isBold, outlineThickness) };
+			addGlyphQuad({ x, y }, color, glyph, italicShear);
+			x += glyph.advance + letterSpacing;
+		}
+		if (x > 0.f)
+			addLines();
+	}
+	void addGlyphQuad(const sf::Vector2f position, const sf::Color color, const sf::Glyph& glyph, const float italicShear)
+	{
+		constexpr float padding{ 1.f };
+
+		const float left{ glyph.bounds.position.x - padding };
+		const float top{ glyph.bounds.position.y - padding };
+		const float right{ glyph.bounds.position.x + glyph.bounds.size.x + padding };
+		const float bottom{ glyph.bounds.position.y + glyph.bounds.size.y + padding };
+
+		const float u1{ static_cast<float>(glyph.textureRect.position.x) - padding };
+		const float v1{ static_cast<float>(glyph.textureRect.position.y) - padding };
+		const float u2{ static_cast<float>(glyph.textureRect.position.x + glyph.textureRect.size.x) + padding };
+		const float v2{ static_cast<float>(glyph.textureRect.position.y + glyph.textureRect.size.y) + padding };
+
+		m_stagingVertices.push_back({ position + sf::Vector2f{ left - (italicShear * top), top }, color, { u1, v1 } });
+		m_stagingVertices.push_back({ position + sf::Vector2f{ right - (italicShear * top), top }, color, { u2, v1 } });
+		m_stagingVertices.push_back({ position + sf::Vector2f{ left - (italicShear * bottom), bottom }, color, { u1, v2 } });
+		m_stagingVertices.push_back({ position + sf::Vector2f{ left - (italicShear * bottom), bottom }, color, { u1, v2 } });
+		m_stagingVertices.push_back({ position + sf::Vector2f{ right - (italicShear * top), top }, color, { u2, v1 } });
+		m_stagingVertices.push_back({ position + sf::Vector2f{ right - (italicShear * bottom), bottom }, color, { u2, v2 } });
+	}
+	// underline or strike-through (uses the font texture's white pixel)
+	void addTextLine(const float lineLength, const float lineTop, const sf::Color color, const float offset, const float thickness, const float outlineThickness)
+	{
+		const float top{ std::floor(lineTop + offset - (thickness / 2.f) + 0.5f) };
+		const float bottom{ top + std::floor(thickness + 0.5f) };
+		const sf::Vector2f texCoords{ 1.f, 1.f };
+
+		m_stagingVertices.push_back({ { -outlineThickness, top - outlineThickness }, color, texCoords });
+		m_stagingVertices.push_back({ { lineLength + outlineThickness, top - outlineThickness }, color, texCoords });
+		m_stagingVertices.push_back({ { -outlineThickness, bottom + outlineThickness }, color, texCoords });
+		m_stagingVertices.push_back({ { -outlineThickness, bottom + outlineThickness }, color, texCoords });
+		m_stagingVertices.push_back({ { lineLength + outlineThickness, top - outlineThickness }, color, texCoords });
+		m_stagingVertices.push_back({ { lineLength + outlineThickness, bottom + outlineThickness }, color, texCoords });
+	}
+};
+
+#endif // HAPAXIA_SFMLSNIPPETS_MIXED_BATCHER
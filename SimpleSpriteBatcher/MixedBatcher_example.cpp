@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023-2026 M.J.Silk
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//
+//       ------------
+//       INTRODUCTION
+//       ------------
+//
+//   Creates a "minimap"-like overlay made of many markers; each marker is a sprite, a rectangle shape, a convex shape (triangle) and a text label.
+//   They are (trivially) randomly placed. Each frame, all of them move slightly. The frame-rate will affect their speed.
+//   The markers can be drawn in one of two ways (toggled by pressing SPACE):
+//     - drawn separately (every sprite, shape and text is its own draw call)
+//     - batched using the mixed batcher (everything is re-batched every frame)
+//   The mixed batcher groups everything by texture so the entire overlay needs only three draw calls:
+//     one for the sprites (their texture), one for the texts (the font's texture) and one for the shapes (no texture).
+//   Note that, since items are grouped by texture, all of the shapes are drawn before all of the texts when batched.
+//     Draw orders (layers) could be given to control this instead (see simpleSpriteBatcher::DrawOrder).
+//
+//
+//       --------
+//       CONTROLS
+//       --------
+//
+//   SPACE			        toggle batcher (starts off)
+//   ESC                    quit
+// 
+// 
+//       -------------
+//       CUSTOMISATION
+//       -------------
+//
+//   You can (should) change the number of markers ('n') created (but not too many!) so that they lower your frame-rate using this line: constexpr std::size_t numberOfMarkers{ 'n' };
+//
+//
+//        ----
+//        NOTE
+//        ----
+//
+//    If the window is too large (1920u, 1080u) for your resolution, you can uncomment the following define line to halve the window size (to 960x540): #define HALVE_WINDOW_SIZE
+//    The texture and font are available in the resources folder, which is in the root folder. You may need to adjust the paths.
+//    You may also need to adjust the path of the included header ("MixedBatcher.hpp") depending on your approach.
+//    Remember to test in both debug and release modes for comparisons. The batcher may be less effective in debug mode.
+// 
+//    This example is for use with SFML 3.
+//
+//
+////////////////////////////////////////////////////////////////
+
+
+
+#include <SFML/Graphics.hpp>
+
+#include "../SimpleSpriteBatcher/MixedBatcher.hpp"
+
+
+
+//#define HALVE_WINDOW_SIZE
+
+
+
+int main()
+{
+	sf::Vector2u windowSize{ 1920u, 1080u };
+#ifdef HALVE_WINDOW_SIZE
+	windowSize /= 2u;
+#endif // HALVE_WINDOW_SIZE
+
+
+
+	// texture and font
+	sf::Texture texture;
+	if (!texture.loadFromFile("resources/images/16colours(16x16_4x4each)-tex.png"))
+		return EXIT_FAILURE;
+	sf::Font font;
+	if (!font.openFromFile("resources/fonts/arial.ttf"))
+		return EXIT_FAILURE;
+
+
+
+	// markers
+	constexpr std::size_t numberOfMarkers{ 2000u }; // change this to a value that is affects your frame-rate. this will be different on every system.
+	std::vector<sf::Sprite> sprites(numberOfMarkers, sf::Sprite(texture));
+	std::vector<sf::RectangleShape> rectangles(numberOfMarkers, sf::RectangleShape({ 20.f, 12.f }));
+	std::vector<sf::ConvexShape> triangles(numberOfMarkers, sf::ConvexShape(3u));
+	std::vector<sf::Text> labels(numberOfMarkers, sf::Text(font, "", 12u));
+	for (std::size_t i{ 0u }; i < numberOfMarkers; ++i)
+	{
+		const sf::Vector2f position{ static_cast<float>(rand() % windowSize.x), static_cast<float>(rand() % windowSize.y) };
+		const std::size_t randomTileIndex{ rand() % 16u };
+		sprites[i].setTextureRect({ { (static_cast<int>(randomTileIndex) % 4) * 4, (static_cast<int>(randomTileIndex) / 4) * 4 }, { 4, 4 } });
+		sprites[i].setScale({ 3.f, 3.f });
+		sprites[i].setPosition(position);
+		rectangles[i].setFillColor(sf::Color(0u, 0u, 0u, 128u));
+		rectangles[i].setOutlineColor(sf::Color::White);
+		rectangles[i].setOutlineThickness(1.f);
+		rectangles[i].setPosition(position + sf::Vector2f{ 14.f, 0.f });
+		triangles[i].setPoint(0u, { 0.f, 0.f });
+		triangles[i].setPoint(1u, { 8.f, 4.f });
+		triangles[i].setPoint(2u, { 0.f, 8.f });
+		triangles[i].setFillColor(sf::Color::Yellow);
+		triangles[i].setPosition(position + sf::Vector2f{ 36.f, 2.f });
+		labels[i].setString(std::to_string(i));
+		labels[i].setPosition(position + sf::Vector2f{ 16.f, -2.f });
+	}
+
+
+
+	// batcher (Mixed Batcher)
+	MixedBatcher batcher;
+
+
+
+	// flag to determine whether to use batcher or not. this can be toggled by pressing SPACE
+	bool useBatcher{ false };
+
+
+
+	sf::Clock clock; // clock for measuring FPS
+	sf::RenderWindow window(sf::VideoMode(windowSize), "");
+	while (window.isOpen())
+	{
+		// update markers
+		for (std::size_t i{ 0u }; i < numberOfMarkers; ++i)
+		{
+			const sf::Vector2f offset{ static_cast<float>((rand() % 3) - 1), static_cast<float>((rand() % 3) - 1) };
+			sprites[i].move(offset);
+			rectangles[i].move(offset);
+			triangles[i].move(offset);
+			labels[i].move(offset);
+		}
+
+		// batch markers
+		if (useBatcher)
+		{
+			batcher.clear();
+			for (std::size_t i{ 0u }; i < numberOfMarkers; ++i)
+			{
+				batcher.add(sprites[i]);
+				batcher.add(rectangles[i]);
+				batcher.add(triangles[i]);
+				batcher.add(labels[i]);
+			}
+			batcher.batch();
+		}
+
+		// show trivial FPS in window title
+		window.setTitle(std::string("BATCHER ") + (useBatcher ? "ON:             " : "OFF:            ") + std::to_string(static_cast<int>(1.f / clock.restart().asSeconds())) + "\tFPS");
+
+		// render
+		window.clear();
+		if (useBatcher)
+			window.draw(batcher);
+		else
+		{
+			for (std::size_t i{ 0u }; i < numberOfMarkers; ++i)
+			{
+				window.draw(sprites[i]);
+				window.draw(rectangles[i]);
+				window.draw(triangles[i]);
+				window.draw(labels[i]);
+			}
+		}
+		window.display();
+
+		// events
+		while (const auto event{ window.pollEvent() })
+		{
+			if (event->is<sf::Event::Closed>())
+				window.close();
+			else if (const auto keyPressed{ event->getIf<sf::Event::KeyPressed>() })
+			{
+				switch (keyPressed->code)
+				{
+				case sf::Keyboard::Key::Escape:
+					window.close();
+					break;
+				case sf::Keyboard::Key::Space:
+					useBatcher = !useBatcher;
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,156 @@
+#ifndef HAPAXIA_SFMLSNIPPETS_PERSISTENT_SPRITE_BATCHER
+#define HAPAXIA_SFMLSNIPPETS_PERSISTENT_SPRITE_BATCHER
+
+#include "SimpleSpriteBatcher.hpp"
+
+// incremental version of the simple sprite batcher
+// sprites are added once and each keeps its own slot (six vertices) until it is removed
+// only the slots that are marked dirty are rewritten when updated; all other slots keep their vertices
+// the batcher does not own the sprites: an added sprite must stay alive (at the same address) until it is removed
+// sprites are drawn in slot order; consecutive slots with the same texture share a draw call
+//     (adding sprites grouped by texture keeps the number of draw calls low)
+// removed slots are left as empty quads and are reused by later additions
+class PersistentSpriteBatcher : public sf::Drawable
+{
+public:
+	PersistentSpriteBatcher() = default;
+	std::size_t addSprite(const sf::Sprite& sprite)
+	{
+		std::size_t slotIndex{ m_slots.size() };
+		if (m_freeSlotIndices.empty())
+		{
+			m_slots.push_back({ &sprite, nullptr, false });
+			m_vertices.resize(m_slots.size() * 6u);
+		}
+		else
+		{
+			slotIndex = m_freeSlotIndices.back();
+			m_freeSlotIndices.pop_back();
+			m_slots[slotIndex].sprite = &sprite;
+		}
+		markDirty(slotIndex);
+		return slotIndex;
+	}
+	void removeSprite(const std::size_t slotIndex)
+	{
+		if ((slotIndex >= m_slots.size()) || (m_slots[slotIndex].sprite == nullptr))
+			return;
+		m_slots[slotIndex].sprite = nullptr;
+		m_freeSlotIndices.push_back(slotIndex);
+		markDirty(slotIndex);
+	}
+	void removeAllSprites()
+	{
+		m_slots.clear();
+		m_dirtySlotIndices.clear();
+		m_freeSlotIndices.clear();
+		m_vertices.clear();
+		m_batches.clear();
+	}
+	// call this whenever a sprite's transform, colour, texture or texture rect has changed
+	void markDirty(const std::size_t slotIndex)
+	{
+		if ((slotIndex >= m_slots.size()) || (m_slots[slotIndex].isDirty))
+			return;
+		m_slots[slotIndex].isDirty = true;
+		m_dirtySlotIndices.push_back(slotIndex);
+	}
+	void markAllDirty()
+	{
+		for (std::size_t i{ 0u }; i < m_slots.size(); ++i)
+			markDirty(i);
+	}
+	// rewrites the vertices of the dirty slots only
+	void update()
+	{
+		bool areBatchesOutdated{ false };
+		for (auto& slotIndex : m_dirtySlotIndices)
+		{
+			Slot& slot{ m_slots[slotIndex] };
+			sf::Vertex* vertices{ m_vertices.data() + (slotIndex * 6u) };
+			const sf::Texture* texture{ nullptr };
+			if (slot.sprite == nullptr)
+			{
+				for (std::size_t v{ 0u }; v < 6u; ++v)
+					vertices[v] = sf::Vertex{};
+			}
+			else
+			{
+				simpleSpriteBatcher::impl::setQuad(vertices, *slot.sprite);
+				texture = &(slot.sprite->getTexture());
+			}
+			if (slot.texture != texture)
+			{
+				slot.texture = texture;
+				areBatchesOutdated = true;
+			}
+			slot.isDirty = false;
+		}
+		m_dirtySlotIndices.clear();
+		if (areBatchesOutdated)
+			updateBatches();
+	}
+	std::size_t getNumberOfSprites() const
+	{
+		return m_slots.size() - m_freeSlotIndices.size();
+	}
+	std::size_t getNumberOfDirtySprites() const
+	{
+		return m_dirtySlotIndices.size();
+	}
+	std::size_t getNumberOfDrawCalls() const
+	{
+		return m_batches.size();
+	}
+
+private:
+	struct Slot
+	{
+		const sf::Sprite* sprite;
+		const sf::Texture* texture; // texture used when the slot was last written (nullptr if empty)
+		bool isDirty;
+	};
+	struct Batch
+	{
+		const sf::Texture* texture;
+		std::size_t startVertex;
+		std::size_t numberOfVertices;
+	};
+
+	std::vector<Slot> m_slots{};
+	std::vector<std::size_t> m_dirtySlotIndices{};
+	std::vector<std::size_t> m_freeSlotIndices{};
+	std::vector<sf::Vertex> m_vertices{};
+	std::vector<Batch> m_batches{};
+
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const
+	{
+		for (auto& batch : m_batches)
+		{
+			states.texture = batch.texture;
+			target.draw(m_vertices.data() + batch.startVertex, batch.numberOfVertices, sf::PrimitiveType::Triangles, states);
+		}
+	}
+
+	// only needed when a slot's texture changes (including slots being filled or emptied)
+	// empty slots never break a batch since their quads have no area
+	void updateBatches()
+	{
+		m_batches.clear();
+		for (std::size_t i{ 0u }; i < m_slots.size(); ++i)
+		{
+			const sf::Texture* texture{ m_slots[i].texture };
+			if (texture == nullptr)
+			{
+				if (!m_batches.empty())
+					m_batches.back().numberOfVertices = ((i + 1u) * 6u) - m_batches.back().startVertex;
+				continue;
+			}
+			if (m_batches.empty() || (m_batches.back().texture != texture))
+				m_batches.push_back({ texture, i * 6u, 0u });
+			m_batches.back().numberOfVertices = ((i + 1u) * 6u) - m_batches.back().startVertex;
+		}
+	}
+};
+
+#endif // HAPAXIA_SFMLSNIPPETS_PERSISTENT_SPRITE_BATCHER
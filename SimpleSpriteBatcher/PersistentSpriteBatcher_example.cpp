@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023-2026 M.J.Silk
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//
+//       ------------
+//       INTRODUCTION
+//       ------------
+//
+//   Creates a large vector of sprites.
+//   They are (trivially) randomly placed, scaled and rotated.
+//   Each frame, only a small portion of them (one in every twenty) are rotated by a set amount; the rest stay still. The frame-rate will affect their speed.
+//   This is a "mostly static" scene: the one that the persistent sprite batcher is designed for.
+//   The sprites can be drawn in one of three ways (cycled by pressing SPACE):
+//     - drawn separately
+//     - batched using the simple sprite batcher (all sprites are re-batched every frame)
+//     - batched using the persistent sprite batcher (only the sprites that were changed are re-batched)
+//   The persistent sprite batcher has its sprites added once (at the start) and each changed sprite is marked as "dirty".
+//
+//
+//       --------
+//       CONTROLS
+//       --------
+//
+//   SPACE			        cycle drawing method (starts drawing separately)
+//   ESC                    quit
+// 
+// 
+//       -------------
+//       CUSTOMISATION
+//       -------------
+//
+//   You can (should) change the number of sprites ('n') created (but not too many!) so that they lower your frame-rate using this line: sprites.resize('n', sf::Sprite(texture));
+//
+//
+//        ----
+//        NOTE
+//        ----
+//
+//    If the window is too large (1920u, 1080u) for your resolution, you can uncomment the following define line to halve the window size (to 960x540): #define HALVE_WINDOW_SIZE
+//    The texture is available in the resources folder, which is in the root folder. You may need to adjust the path.
+//    You may also need to adjust the path of the included headers ("SimpleSpriteBatcher.hpp" and "PersistentSpriteBatcher.hpp") depending on your approach.
+//    Remember to test in both debug and release modes for comparisons. The batchers may be less effective in debug mode.
+// 
+//    This example is for use with SFML 3.
+//
+//
+////////////////////////////////////////////////////////////////
+
+
+
+#include <SFML/Graphics.hpp>
+
+#include "../SimpleSpriteBatcher/SimpleSpriteBatcher.hpp"
+#include "../SimpleSpriteBatcher/PersistentSpriteBatcher.hpp"
+
+
+
+//#define HALVE_WINDOW_SIZE
+
+
+
+int main()
+{
+	sf::Vector2u windowSize{ 1920u, 1080u };
+#ifdef HALVE_WINDOW_SIZE
+	windowSize /= 2u;
+#endif // HALVE_WINDOW_SIZE
+
+
+
+	// texture
+	sf::Texture texture;
+	if (!texture.loadFromFile("resources/images/16colours(16x16_4x4each)-tex.png"))
+		return EXIT_FAILURE;
+
+
+
+	// sprites
+	std::vector<sf::Sprite> sprites;
+	sprites.resize(100000u, sf::Sprite(texture)); // change this to a value that is affects your frame-rate. this will be different on every system.
+	for (auto& sprite : sprites)
+	{
+		const std::size_t randomTileIndex{ rand() % 16u };
+		sprite.setTextureRect({ { (static_cast<int>(randomTileIndex) % 4) * 4, (static_cast<int>(randomTileIndex) / 4) * 4 }, { 4, 4 } });
+		const float scale{ ((rand() % 950) + 50) / 100.f };
+		sprite.setScale({ scale , scale });
+		sprite.setPosition({ static_cast<float>(rand() % windowSize.x), static_cast<float>(rand() % windowSize.y) });
+		sprite.setRotation(sf::degrees((rand() % 1000) * 0.36f));
+	}
+	constexpr std::size_t animatedSpriteStep{ 20u }; // only one in every 'animatedSpriteStep' sprites is rotated
+
+
+
+	// batchers
+	SimpleSpriteBatcher simpleBatcher;
+	PersistentSpriteBatcher persistentBatcher;
+	for (auto& sprite : sprites)
+		persistentBatcher.addSprite(sprite); // slot indices match sprite indices here since all sprites are added in order
+
+
+
+	// drawing method. this can be cycled by pressing SPACE
+	enum class Method
+	{
+		Separate,
+		Simple,
+		Persistent,
+	} method{ Method::Separate };
+
+
+
+	sf::Clock clock; // clock for measuring FPS
+	sf::RenderWindow window(sf::VideoMode(windowSize), "");
+	while (window.isOpen())
+	{
+		// update sprites
+		for (std::size_t i{ 0u }; i < sprites.size(); i += animatedSpriteStep)
+		{
+			sprites[i].rotate(sf::degrees(2.f));
+			persistentBatcher.markDirty(i);
+		}
+
+		// batch sprites
+		switch (method)
+		{
+		case Method::Simple:
+			simpleBatcher.batchSprites(sprites);
+			break;
+		case Method::Persistent:
+			persistentBatcher.update();
+			break;
+		case Method::Separate:
+			break;
+		}
+
+		// show trivial FPS in window title
+		const std::string methodName{ (method == Method::Separate) ? "SEPARATE:       " : (method == Method::Simple) ? "SIMPLE:         " : "PERSISTENT:     " };
+		window.setTitle(methodName + std::to_string(static_cast<int>(1.f / clock.restart().asSeconds())) + "\tFPS");
+
+		// render
+		window.clear();
+		switch (method)
+		{
+		case Method::Simple:
+			window.draw(simpleBatcher);
+			break;
+		case Method::Persistent:
+			window.draw(persistentBatcher);
+			break;
+		case Method::Separate:
+			for (auto& sprite : sprites)
+				window.draw(sprite);
+			break;
+		}
+		window.display();
+
+		// events
+		while (const auto event{ window.pollEvent() })
+		{
+			if (event->is<sf::Event::Closed>())
+				window.close();
+			else if (const auto keyPressed{ event->getIf<sf::Event::KeyPressed>() })
+			{
+				switch (keyPressed->code)
+				{
+				case sf::Keyboard::Key::Escape:
+					window.close();
+					break;
+				case sf::Keyboard::Key::Space:
+					method = (method == Method::Separate) ? Method::Simple : (method == Method::Simple) ? Method::Persistent : Method::Separate;
+					break;
+				}
+			}
+		}
+	}
+}
@@ -1,68 +1,1066 @@
 #ifndef HAPAXIA_SFMLSNIPPETS_SIMPLE_SPRITE_BATCHER
 #define HAPAXIA_SFMLSNIPPETS_SIMPLE_SPRITE_BATCHER
 
+#include "../WorkerPool/WorkerPool.hpp"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 
+#if !defined(SIMPLE_SPRITE_BATCHER_NO_SIMD)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SIMPLE_SPRITE_BATCHER_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SIMPLE_SPRITE_BATCHER_SIMD_SSE
+#endif
+#endif // SIMPLE_SPRITE_BATCHER_NO_SIMD
+
+namespace simpleSpriteBatcher
+{
+
+// lower layers are drawn first. within a layer, sprites are grouped by texture and each group is drawn in order of depth (lower depth first)
+// sprites with equal draw orders (and textures) keep their original order
+// the texture is part of the sort key (16 bits) so at most 65536 different textures can be sorted at once; more than that throws std::length_error
+struct DrawOrder
+{
+	std::int16_t layer{ 0 };
+	float depth{ 0.f };
+};
+
+// translates a sprite's texture and texture rect to another texture and texture rect of the same size (e.g. a region of a texture atlas)
+// remap should return false (and leave both unchanged) if the sprite is not translated
+class TextureRemap
+{
+public:
+	virtual ~TextureRemap() = default;
+	virtual bool remap(const sf::Texture*& texture, sf::IntRect& textureRect) const = 0;
+};
+
+	namespace impl
+	{
+
+// writes the two triangles (six vertices) that represent the sprite
+inline void setQuad(sf::Vertex* vertices, const sf::Sprite& sprite)
+{
+	const sf::Transform transform{ sprite.getTransform() };
+	const sf::Color color{ sprite.getColor() };
+	const sf::IntRect rect{ sprite.getTextureRect() };
+
+	sf::Vector2f shapeTopLeft{ 0.f, 0.f };
+	sf::Vector2f shapeBottomRight(rect.size);
+	sf::Vector2f shapeTopRight{ shapeBottomRight.x, shapeTopLeft.y };
+	sf::Vector2f shapeBottomLeft{ shapeTopLeft.x, shapeBottomRight.y };
+	const sf::Vector2f textureTopLeft(rect.position);
+	const sf::Vector2f textureBottomRight{ textureTopLeft + shapeBottomRight };
+	const sf::Vector2f textureTopRight{ textureBottomRight.x, textureTopLeft.y };
+	const sf::Vector2f textureBottomLeft{ textureTopLeft.x, textureBottomRight.y };
+	shapeTopLeft = transform.transformPoint(shapeTopLeft);
+	shapeBottomRight = transform.transformPoint(shapeBottomRight);
+	shapeTopRight = transform.transformPoint(shapeTopRight);
+	shapeBottomLeft = transform.transformPoint(shapeBottomLeft);
+
+	vertices[0u].position = shapeTopLeft;
+	vertices[0u].texCoords = textureTopLeft;
+	vertices[0u].color = color;
+	vertices[1u].position = shapeBottomLeft;
+	vertices[1u].texCoords = textureBottomLeft;
+	vertices[1u].color = color;
+	vertices[2u].position = shapeBottomRight;
+	vertices[2u].texCoords = textureBottomRight;
+	vertices[2u].color = color;
+	vertices[5u].position = shapeTopRight;
+	vertices[5u].texCoords = textureTopRight;
+	vertices[5u].color = color;
+
+	vertices[3u] = vertices[0u];
+	vertices[4u] = vertices[2u];
+}
+
+#if defined(SIMPLE_SPRITE_BATCHER_SIMD_AVX)
+struct Lanes
+{
+	using Type = __m256;
+	static constexpr std::size_t count{ 8u };
+	static Type load(const float* values) { return _mm256_loadu_ps(values); }
+	static void store(float* values, const Type a) { _mm256_storeu_ps(values, a); }
+	static Type add(const Type a, const Type b) { return _mm256_add_ps(a, b); }
+	static Type subtract(const Type a, const Type b) { return _mm256_sub_ps(a, b); }
+	static Type multiply(const Type a, const Type b) { return _mm256_mul_ps(a, b); }
+	static Type negate(const Type a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.f)); }
+};
+#elif defined(SIMPLE_SPRITE_BATCHER_SIMD_SSE)
+struct Lanes
+{
+	using Type = __m128;
+	static constexpr std::size_t count{ 4u };
+	static Type load(const float* values) { return _mm_loadu_ps(values); }
+	static void store(float* values, const Type a) { _mm_storeu_ps(values, a); }
+	static Type add(const Type a, const Type b) { return _mm_add_ps(a, b); }
+	static Type subtract(const Type a, const Type b) { return _mm_sub_ps(a, b); }
+	static Type multiply(const Type a, const Type b) { return _mm_mul_ps(a, b); }
+	static Type negate(const Type a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+};
+#endif
+
+struct Identity
+{
+	template <class T>
+	T&& operator()(T&& t) const { return std::forward<T>(t); }
+};
+
+inline const sf::Sprite* toSpritePointer(const sf::Sprite& sprite)
+{
+	return &sprite;
+}
+// pointers (including smart pointers) to sprites
+template <class T>
+const sf::Sprite* toSpritePointer(const T& pointer)
+{
+	return &(*pointer);
+}
+
+// writes the six vertices of a quad from its four (transformed) corners
+inline void setQuadVertices(sf::Vertex* vertices, const sf::Vector2f topLeft, const sf::Vector2f topRight, const sf::Vector2f bottomRight, const sf::Vector2f bottomLeft, const sf::Vector2f textureTopLeft, const sf::Vector2f textureBottomRight, const sf::Color color)
+{
+	vertices[0u].position = topLeft;
+	vertices[0u].texCoords = textureTopLeft;
+	vertices[0u].color = color;
+	vertices[1u].position = bottomLeft;
+	vertices[1u].texCoords = { textureTopLeft.x, textureBottomRight.y };
+	vertices[1u].color = color;
+	vertices[2u].position = bottomRight;
+	vertices[2u].texCoords = textureBottomRight;
+	vertices[2u].color = color;
+	vertices[5u].position = topRight;
+	vertices[5u].texCoords = { textureBottomRight.x, textureTopLeft.y };
+	vertices[5u].color = color;
+
+	vertices[3u] = vertices[0u];
+	vertices[4u] = vertices[2u];
+}
+
+// stable LSD radix sort of the items by their keys (one byte per pass)
+// passes where every key has the same byte are skipped
+// returns true if any pass was performed (if not, the items are in their original order)
+struct SortItem
+{
+	std::uint64_t key;
+	std::size_t index;
+};
+inline bool radixSort(std::vector<SortItem>& items, std::vector<SortItem>& buffer)
+{
+	constexpr std::size_t numberOfPasses{ sizeof(std::uint64_t) };
+	const std::size_t numberOfItems{ items.size() };
+	if (numberOfItems < 2u)
+		return false;
+
+	std::size_t counts[numberOfPasses][256u]{};
+	for (auto& item : items)
+	{
+		for (std::size_t pass{ 0u }; pass < numberOfPasses; ++pass)
+			++counts[pass][(item.key >> (pass * 8u)) & 0xFFu];
+	}
+
+	bool isSorted{ false };
+	buffer.resize(numberOfItems);
+	for (std::size_t pass{ 0u }; pass < numberOfPasses; ++pass)
+	{
+		const std::size_t shift{ pass * 8u };
+		std::size_t* passCounts{ counts[pass] };
+		if (passCounts[(items.front().key >> shift) & 0xFFu] == numberOfItems)
+			continue;
+
+		std::size_t offset{ 0u };
+		for (std::size_t digit{ 0u }; digit < 256u; ++digit)
+		{
+			const std::size_t count{ passCounts[digit] };
+			passCounts[digit] = offset;
+			offset += count;
+		}
+		for (auto& item : items)
+			buffer[passCounts[(item.key >> shift) & 0xFFu]++] = item;
+		items.swap(buffer);
+		isSorted = true;
+	}
+	return isSorted;
+}
+
+// bits of a float that sort (as an unsigned integer) in the same order as the float
+inline std::uint32_t getSortableBits(float value)
+{
+	if (value == 0.f)
+		value = 0.f; // -0 and +0 are equal
+	std::uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return ((bits & 0x80000000u) != 0u) ? ~bits : (bits | 0x80000000u);
+}
+
+constexpr std::size_t maximumNumberOfTextures{ 0x10000u }; // texture indices must fit in the sort key
+
+// layer (16 bits), texture index (16 bits), depth (32 bits)
+inline std::uint64_t createSortKey(const std::int16_t layer, const std::size_t textureIndex, const float depth)
+{
+	return (static_cast<std::uint64_t>(static_cast<std::uint16_t>(layer) ^ 0x8000u) << 48u) | (static_cast<std::uint64_t>(textureIndex & 0xFFFFu) << 32u) | getSortableBits(depth);
+}
+inline std::size_t getTextureIndexFromSortKey(const std::uint64_t key)
+{
+	return static_cast<std::size_t>((key >> 32u) & 0xFFFFu);
+}
+
+// sorts items (by layer, texture and depth) into sortItems; each sort item's index is the index of its item
+// textures are indexed in order of first appearance and are stored in textures (so a sort key's texture index is an index into textures)
+// returns true if any sorting pass was performed (see radixSort)
+// throws std::length_error if there are more textures than a sort key can hold (maximumNumberOfTextures)
+template <class TextureAt, class DrawOrderAt>
+bool sortByDrawOrder(const std::size_t numberOfItems, TextureAt textureAt, DrawOrderAt drawOrderAt, std::vector<const sf::Texture*>& textures, std::vector<SortItem>& sortItems, std::vector<SortItem>& sortItemsBuffer)
+{
+	textures.clear();
+	sortItems.resize(numberOfItems);
+	std::size_t textureIndex{ 0u };
+	for (std::size_t i{ 0u }; i < numberOfItems; ++i)
+	{
+		const sf::Texture* itemTexture{ textureAt(i) };
+		if (textures.empty() || (textures[textureIndex] != itemTexture))
+		{
+			textureIndex = static_cast<std::size_t>(std::find(textures.begin(), textures.end(), itemTexture) - textures.begin());
+			if (textureIndex == textures.size())
+			{
+				if (textureIndex == maximumNumberOfTextures)
+					throw std::length_error("simpleSpriteBatcher: too many different textures to sort (maximum is 65536)");
+				textures.push_back(itemTexture);
+			}
+		}
+		const DrawOrder drawOrder{ drawOrderAt(i) };
+		sortItems[i] = { createSortKey(drawOrder.layer, textureIndex, drawOrder.depth), i };
+	}
+	return radixSort(sortItems, sortItemsBuffer);
+}
+
+	} // namespace impl
+
+// structure-of-arrays store of sprite data (position, origin, scale, rotation, texture rect, colour, texture and draw order)
+// it contains the same data that a sprite uses to create its quad but each property is kept in its own contiguous array
+// the rotation's cosine and sine are calculated when it is set so that writing quads requires no trigonometry
+// writing quads processes multiple instances at once using SSE or AVX (if available) and the remainder one at a time
+// the SIMD and scalar calculations are identical, operation for operation, so give identical results
+//     (if your compiler is allowed to contract multiplies and adds into FMA instructions, disable it, e.g. -ffp-contract=off, to keep them identical)
+// define SIMPLE_SPRITE_BATCHER_NO_SIMD to always use the scalar calculations
+class SpriteInstances
+{
+public:
+	std::size_t add(const sf::Texture& texture, const sf::IntRect textureRect, const sf::Vector2f position = { 0.f, 0.f }, const sf::Vector2f origin = { 0.f, 0.f }, const sf::Vector2f scale = { 1.f, 1.f }, const sf::Angle rotation = sf::Angle::Zero, const sf::Color color = sf::Color::White)
+	{
+		const std::size_t index{ getSize() };
+		resize(index + 1u);
+		setTexture(index, texture);
+		setTextureRect(index, textureRect);
+		setPosition(index, position);
+		setOrigin(index, origin);
+		setScale(index, scale);
+		setRotation(index, rotation);
+		setColor(index, color);
+		return index;
+	}
+	std::size_t add(const sf::Sprite& sprite)
+	{
+		return add(sprite.getTexture(), sprite.getTextureRect(), sprite.getPosition(), sprite.getOrigin(), sprite.getScale(), sprite.getRotation(), sprite.getColor());
+	}
+	void clear()
+	{
+		resize(0u);
+	}
+	void resize(const std::size_t size)
+	{
+		m_positionsX.resize(size, 0.f);
+		m_positionsY.resize(size, 0.f);
+		m_originsX.resize(size, 0.f);
+		m_originsY.resize(size, 0.f);
+		m_scalesX.resize(size, 1.f);
+		m_scalesY.resize(size, 1.f);
+		m_rotations.resize(size, sf::Angle::Zero);
+		m_cosines.resize(size, 1.f);
+		m_sines.resize(size, 0.f);
+		m_textureRectsLeft.resize(size, 0.f);
+		m_textureRectsTop.resize(size, 0.f);
+		m_textureRectsWidth.resize(size, 0.f);
+		m_textureRectsHeight.resize(size, 0.f);
+		m_colors.resize(size, sf::Color::White);
+		m_textures.resize(size, nullptr);
+		m_drawOrders.resize(size, DrawOrder{});
+	}
+	void reserve(const std::size_t capacity)
+	{
+		m_positionsX.reserve(capacity);
+		m_positionsY.reserve(capacity);
+		m_originsX.reserve(capacity);
+		m_originsY.reserve(capacity);
+		m_scalesX.reserve(capacity);
+		m_scalesY.reserve(capacity);
+		m_rotations.reserve(capacity);
+		m_cosines.reserve(capacity);
+		m_sines.reserve(capacity);
+		m_textureRectsLeft.reserve(capacity);
+		m_textureRectsTop.reserve(capacity);
+		m_textureRectsWidth.reserve(capacity);
+		m_textureRectsHeight.reserve(capacity);
+		m_colors.reserve(capacity);
+		m_textures.reserve(capacity);
+		m_drawOrders.reserve(capacity);
+	}
+	std::size_t getSize() const
+	{
+		return m_positionsX.size();
+	}
+
+	void setPosition(const std::size_t index, const sf::Vector2f position)
+	{
+		m_positionsX[index] = position.x;
+		m_positionsY[index] = position.y;
+	}
+	void move(const std::size_t index, const sf::Vector2f offset)
+	{
+		m_positionsX[index] += offset.x;
+		m_positionsY[index] += offset.y;
+	}
+	void setOrigin(const std::size_t index, const sf::Vector2f origin)
+	{
+		m_originsX[index] = origin.x;
+		m_originsY[index] = origin.y;
+	}
+	void setScale(const std::size_t index, const sf::Vector2f scale)
+	{
+		m_scalesX[index] = scale.x;
+		m_scalesY[index] = scale.y;
+	}
+	void setRotation(const std::size_t index, const sf::Angle rotation)
+	{
+		// matches sf::Transformable (the angle is wrapped to [0, 360) degrees and the transform uses the negated angle)
+		m_rotations[index] = rotation.wrapUnsigned();
+		const float angle{ -m_rotations[index].asRadians() };
+		m_cosines[index] = std::cos(angle);
+		m_sines[index] = std::sin(angle);
+	}
+	void rotate(const std::size_t index, const sf::Angle angle)
+	{
+		setRotation(index, m_rotations[index] + angle);
+	}
+	void setTextureRect(const std::size_t index, const sf::IntRect textureRect)
+	{
+		m_textureRectsLeft[index] = static_cast<float>(textureRect.position.x);
+		m_textureRectsTop[index] = static_cast<float>(textureRect.position.y);
+		m_textureRectsWidth[index] = static_cast<float>(textureRect.size.x);
+		m_textureRectsHeight[index] = static_cast<float>(textureRect.size.y);
+	}
+	void setColor(const std::size_t index, const sf::Color color)
+	{
+		m_colors[index] = color;
+	}
+	void setTexture(const std::size_t index, const sf::Texture& texture)
+	{
+		m_textures[index] = &texture;
+	}
+	void setDrawOrder(const std::size_t index, const DrawOrder drawOrder)
+	{
+		m_drawOrders[index] = drawOrder;
+	}
+
+	sf::Vector2f getPosition(const std::size_t index) const
+	{
+		return { m_positionsX[index], m_positionsY[index] };
+	}
+	sf::Vector2f getOrigin(const std::size_t index) const
+	{
+		return { m_originsX[index], m_originsY[index] };
+	}
+	sf::Vector2f getScale(const std::size_t index) const
+	{
+		return { m_scalesX[index], m_scalesY[index] };
+	}
+	sf::Angle getRotation(const std::size_t index) const
+	{
+		return m_rotations[index];
+	}
+	sf::IntRect getTextureRect(const std::size_t index) const
+	{
+		return { { static_cast<int>(m_textureRectsLeft[index]), static_cast<int>(m_textureRectsTop[index]) }, { static_cast<int>(m_textureRectsWidth[index]), static_cast<int>(m_textureRectsHeight[index]) } };
+	}
+	sf::Color getColor(const std::size_t index) const
+	{
+		return m_colors[index];
+	}
+	const sf::Texture* getTexture(const std::size_t index) const
+	{
+		return m_textures[index];
+	}
+	DrawOrder getDrawOrder(const std::size_t index) const
+	{
+		return m_drawOrders[index];
+	}
+
+	// writes the quads of the instances in [begin, end)
+	// each instance's quad starts at its start vertex (from startVertices) or, if startVertices is nullptr, at (index * 6)
+	void writeQuads(sf::Vertex* vertices, const std::size_t* startVertices, std::size_t begin, const std::size_t end, const bool useSimd = true) const
+	{
+#if defined(SIMPLE_SPRITE_BATCHER_SIMD_AVX) || defined(SIMPLE_SPRITE_BATCHER_SIMD_SSE)
+		if (useSimd)
+		{
+			using Lanes = impl::Lanes;
+			for (; (begin + Lanes::count) <= end; begin += Lanes::count)
+				writeQuadsSimd<Lanes>(vertices, startVertices, begin);
+		}
+#else
+		static_cast<void>(useSimd);
+#endif
+		for (; begin < end; ++begin)
+			writeQuad(vertices + ((startVertices == nullptr) ? (begin * 6u) : startVertices[begin]), begin);
+	}
+
+private:
+	std::vector<float> m_positionsX{};
+	std::vector<float> m_positionsY{};
+	std::vector<float> m_originsX{};
+	std::vector<float> m_originsY{};
+	std::vector<float> m_scalesX{};
+	std::vector<float> m_scalesY{};
+	std::vector<sf::Angle> m_rotations{};
+	std::vector<float> m_cosines{};
+	std::vector<float> m_sines{};
+	std::vector<float> m_textureRectsLeft{};
+	std::vector<float> m_textureRectsTop{};
+	std::vector<float> m_textureRectsWidth{};
+	std::vector<float> m_textureRectsHeight{};
+	std::vector<sf::Color> m_colors{};
+	std::vector<const sf::Texture*> m_textures{};
+	std::vector<DrawOrder> m_drawOrders{};
+
+	// same calculation as sf::Transformable::getTransform followed by sf::Transform::transformPoint for each corner
+	void writeQuad(sf::Vertex* vertices, const std::size_t index) const
+	{
+		const float scaleXCosine{ m_scalesX[index] * m_cosines[index] };
+		const float scaleYCosine{ m_scalesY[index] * m_cosines[index] };
+		const float scaleXSine{ m_scalesX[index] * m_sines[index] };
+		const float scaleYSine{ m_scalesY[index] * m_sines[index] };
+		const float translationX{ ((-m_originsX[index] * scaleXCosine) - (m_originsY[index] * scaleYSine)) + m_positionsX[index] };
+		const float translationY{ ((m_originsX[index] * scaleXSine) - (m_originsY[index] * scaleYCosine)) + m_positionsY[index] };
+		const float negativeScaleXSine{ -scaleXSine };
+		const float width{ m_textureRectsWidth[index] };
+		const float height{ m_textureRectsHeight[index] };
+
+		const sf::Vector2f topRight{ (scaleXCosine * width) + translationX, (negativeScaleXSine * width) + translationY };
+		const sf::Vector2f bottomLeft{ (scaleYSine * height) + translationX, (scaleYCosine * height) + translationY };
+		const sf::Vector2f bottomRight{ ((scaleXCosine * width) + (scaleYSine * height)) + translationX, ((negativeScaleXSine * width) + (scaleYCosine * height)) + translationY };
+		const sf::Vector2f textureTopLeft{ m_textureRectsLeft[index], m_textureRectsTop[index] };
+		impl::setQuadVertices(vertices, { translationX, translationY }, topRight, bottomRight, bottomLeft, textureTopLeft, { textureTopLeft.x + width, textureTopLeft.y + height }, m_colors[index]);
+	}
+
+#if defined(SIMPLE_SPRITE_BATCHER_SIMD_AVX) || defined(SIMPLE_SPRITE_BATCHER_SIMD_SSE)
+	// calculates the corners of (Lanes::count) instances at once then writes each of their quads
+	template <class Lanes>
+	void writeQuadsSimd(sf::Vertex* vertices, const std::size_t* startVertices, const std::size_t begin) const
+	{
+		using Type = typename Lanes::Type;
+		const Type cosine{ Lanes::load(m_cosines.data() + begin) };
+		const Type sine{ Lanes::load(m_sines.data() + begin) };
+		const Type scaleX{ Lanes::load(m_scalesX.data() + begin) };
+		const Type scaleY{ Lanes::load(m_scalesY.data() + begin) };
+		const Type originX{ Lanes::load(m_originsX.data() + begin) };
+		const Type originY{ Lanes::load(m_originsY.data() + begin) };
+		const Type width{ Lanes::load(m_textureRectsWidth.data() + begin) };
+		const Type height{ Lanes::load(m_textureRectsHeight.data() + begin) };
+
+		const Type scaleXCosine{ Lanes::multiply(scaleX, cosine) };
+		const Type scaleYCosine{ Lanes::multiply(scaleY, cosine) };
+		const Type scaleXSine{ Lanes::multiply(scaleX, sine) };
+		const Type scaleYSine{ Lanes::multiply(scaleY, sine) };
+		const Type translationX{ Lanes::add(Lanes::subtract(Lanes::multiply(Lanes::negate(originX), scaleXCosine), Lanes::multiply(originY, scaleYSine)), Lanes::load(m_positionsX.data() + begin)) };
+		const Type translationY{ Lanes::add(Lanes::subtract(Lanes::multiply(originX, scaleXSine), Lanes::multiply(originY, scaleYCosine)), Lanes::load(m_positionsY.data() + begin)) };
+		const Type negativeScaleXSine{ Lanes::negate(scaleXSine) };
+
+		const Type rightX{ Lanes::multiply(scaleXCosine, width) };
+		const Type rightY{ Lanes::multiply(negativeScaleXSine, width) };
+		const Type bottomX{ Lanes::multiply(scaleYSine, height) };
+		const Type bottomY{ Lanes::multiply(scaleYCosine, height) };
+
+		float topLeftX[Lanes::count];
+		float topLeftY[Lanes::count];
+		float topRightX[Lanes::count];
+		float topRightY[Lanes::count];
+		float bottomLeftX[Lanes::count];
+		float bottomLeftY[Lanes::count];
+		float bottomRightX[Lanes::count];
+		float bottomRightY[Lanes::count];
+		Lanes::store(topLeftX, translationX);
+		Lanes::store(topLeftY, translationY);
+		Lanes::store(topRightX, Lanes::add(rightX, translationX));
+		Lanes::store(topRightY, Lanes::add(rightY, translationY));
+		Lanes::store(bottomLeftX, Lanes::add(bottomX, translationX));
+		Lanes::store(bottomLeftY, Lanes::add(bottomY, translationY));
+		Lanes::store(bottomRightX, Lanes::add(Lanes::add(rightX, bottomX), translationX));
+		Lanes::store(bottomRightY, Lanes::add(Lanes::add(rightY, bottomY), translationY));
+
+		for (std::size_t lane{ 0u }; lane < Lanes::count; ++lane)
+		{
+			const std::size_t index{ begin + lane };
+			const sf::Vector2f textureTopLeft{ m_textureRectsLeft[index], m_textureRectsTop[index] };
+			impl::setQuadVertices(vertices + ((startVertices == nullptr) ? (index * 6u) : startVertices[index]),
+				{ topLeftX[lane], topLeftY[lane] },
+				{ topRightX[lane], topRightY[lane] },
+				{ bottomRightX[lane], bottomRightY[lane] },
+				{ bottomLeftX[lane], bottomLeftY[lane] },
+				textureTopLeft,
+				{ textureTopLeft.x + m_textureRectsWidth[index], textureTopLeft.y + m_textureRectsHeight[index] },
+				m_colors[index]);
+		}
+	}
+#endif
+};
+
+} // namespace simpleSpriteBatcher
+
+// sprites are grouped by their own texture; each group is drawn with a single draw call
+// groups are drawn in the order their textures first appear and sprites keep their order within their group
+// if 'texture' is set, it is used for all sprites instead (no grouping; single draw call)
+// optionally, each sprite can be given a draw order (layer and depth; see simpleSpriteBatcher::DrawOrder)
+//     sprites are then sorted by layer, texture and depth (in that order) using a stable radix sort
+//     a new draw call is needed each time the texture changes in that order
+//     up to 65536 different textures are supported (more throws std::length_error)
+// quads can optionally be written by multiple threads (see setNumberOfThreads); the result is identical to using a single thread
+// alternatively, the batcher's own sprite instances ('instances') can be batched using batchInstances (see simpleSpriteBatcher::SpriteInstances)
+// if a visible rect is set (see setVisibleRect), batchSprites skips any sprite whose global bounds do not intersect it (batchInstances does not cull)
+// if 'textureRemap' is set, batchSprites uses it to translate each sprite's texture and texture rect (e.g. to a texture atlas) before grouping
+//     it is not used if 'texture' is set or by batchInstances
+// optionally, the vertices can be drawn from vertex buffers that are only updated where they have changed (see setNumberOfVertexBuffers)
 class SimpleSpriteBatcher : public sf::Drawable
 {
 public:
 	sf::Texture* texture{ nullptr };
+	const simpleSpriteBatcher::TextureRemap* textureRemap{ nullptr };
+	simpleSpriteBatcher::SpriteInstances instances{};
+	bool useSimd{ true }; // only affects batchInstances
 	SimpleSpriteBatcher() = default;
-	void batchSprites(const std::vector<sf::Sprite>& sprites)
+	// sprites can be any range (e.g. std::vector, std::deque, std::array, std::span or a ranges view) of sprites or of pointers to sprites
+	// projection (optional) is applied to each element and must return a sprite reference (const sf::Sprite&) or a pointer to a sprite
+	// drawOrders (optional) must be a random-access range with one draw order per element (matching indices)
+	// elements of a range that is not random-access are first collected (as sprite pointers) into the batcher's own storage
+	template <class SpriteRange>
+	void batchSprites(SpriteRange&& sprites)
+	{
+		batchSprites(sprites, simpleSpriteBatcher::impl::Identity{});
+	}
+	template <class SpriteRange, class ProjectionOrDrawOrders>
+	void batchSprites(SpriteRange&& sprites, const ProjectionOrDrawOrders& projectionOrDrawOrders)
+	{
+		if constexpr (std::is_invocable_v<const ProjectionOrDrawOrders&, decltype(*std::begin(sprites))>)
+			batchSpriteRange(sprites, [](std::size_t) { return simpleSpriteBatcher::DrawOrder{}; }, projectionOrDrawOrders);
+		else
+			batchSprites(sprites, projectionOrDrawOrders, simpleSpriteBatcher::impl::Identity{});
+	}
+	template <class SpriteRange, class DrawOrderRange, class Projection>
+	void batchSprites(SpriteRange&& sprites, const DrawOrderRange& drawOrders, const Projection& projection)
+	{
+		const auto drawOrdersBegin{ std::begin(drawOrders) };
+		batchSpriteRange(sprites, [&drawOrdersBegin](const std::size_t i) -> simpleSpriteBatcher::DrawOrder { return drawOrdersBegin[static_cast<std::ptrdiff_t>(i)]; }, projection);
+	}
+	void batchInstances()
 	{
-		m_vertices.resize(sprites.size() * 6u);
-		for (std::size_t i{ 0u }; i < sprites.size(); ++i)
-			setQuad(&(sprites[i]), i * 6u);
+		const std::size_t numberOfInstances{ instances.getSize() };
+		prepareVertices(numberOfInstances * 6u);
+		m_batches.clear();
+		m_statistics = { numberOfInstances, 0u, numberOfInstances, 0u };
+		if (numberOfInstances == 0u)
+			return;
+
+		sortIntoBatches(numberOfInstances, [this](const std::size_t i) { return instances.getTexture(i); }, [this](const std::size_t i) { return instances.getDrawOrder(i); });
+		const std::size_t* startVertices{ m_isInputOrder ? nullptr : m_spriteStartVertices.data() };
+		forEachSpriteRange(numberOfInstances, [this, startVertices](const std::size_t begin, const std::size_t end)
+		{
+			instances.writeQuads(m_vertices.data(), startVertices, begin, end, useSimd);
+		});
+		m_statistics.numberOfDrawCalls = m_batches.size();
+		if (!m_vertexBuffers.empty())
+		{
+			addDirtyRange({ 0u, m_numberOfVertices });
+			m_currentVertexBuffer = (m_currentVertexBuffer + 1u) % m_vertexBuffers.size();
+		}
+	}
+	std::size_t getNumberOfDrawCalls() const
+	{
+		return m_batches.size();
+	}
+
+	struct Statistics
+	{
+		std::size_t numberOfSprites{ 0u };
+		std::size_t numberOfCulledSprites{ 0u };
+		std::size_t numberOfBatchedSprites{ 0u };
+		std::size_t numberOfDrawCalls{ 0u };
+	};
+	// statistics of the most recent batch
+	Statistics getStatistics() const
+	{
+		return m_statistics;
+	}
+
+	void setVisibleRect(const sf::FloatRect& visibleRect)
+	{
+		m_visibleRect = visibleRect;
+		m_isCulling = true;
+	}
+	// uses the area of the world shown by the view (this can be the render target's view: target.getView())
+	void setVisibleRect(const sf::View& view)
+	{
+		sf::Transform rotation;
+		rotation.rotate(view.getRotation(), view.getCenter());
+		setVisibleRect(rotation.transformRect({ view.getCenter() - (view.getSize() / 2.f), view.getSize() }));
+	}
+	void clearVisibleRect()
+	{
+		m_isCulling = false;
+	}
+	bool isCulling() const
+	{
+		return m_isCulling;
 	}
-	void batchSprites(const std::vector<sf::Sprite*>& sprites)
+	// 1 (default) writes all quads on the calling thread
+	// 0 uses as many threads as the hardware supports
+	// the calling thread is always one of the threads used
+	void setNumberOfThreads(std::size_t numberOfThreads)
 	{
-		m_vertices.resize(sprites.size() * 6u);
-		for (std::size_t i{ 0u }; i < sprites.size(); ++i)
-			setQuad(sprites[i], i * 6u);
+		if (numberOfThreads == 0u)
+			numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		if (numberOfThreads == getNumberOfThreads())
+			return;
+		m_workerPool.reset();
+		if (numberOfThreads > 1u)
+			m_workerPool = std::make_unique<workerPool::WorkerPool>(numberOfThreads - 1u);
+	}
+	std::size_t getNumberOfThreads() const
+	{
+		return (m_workerPool) ? m_workerPool->getNumberOfThreads() : 1u;
+	}
+
+	// storage only ever grows (it is never released by batching fewer sprites) so, once it has grown large enough, batching does not allocate
+	// reserve allows the storage to be allocated up front; shrinkToFit releases any that is not currently needed
+	void reserve(const std::size_t numberOfSprites)
+	{
+		m_vertices.reserve(numberOfSprites * 6u);
+		m_spriteStartVertices.reserve(numberOfSprites);
+		m_sortItems.reserve(numberOfSprites);
+		m_sortItemsBuffer.reserve(numberOfSprites);
+		m_spriteVisibilities.reserve(numberOfSprites);
+		m_visibleSpriteIndices.reserve(numberOfSprites);
+		m_spritePointers.reserve(numberOfSprites);
+		if (textureRemap != nullptr)
+			m_textureOffsets.reserve(numberOfSprites);
+		if (!m_vertexBuffers.empty())
+			m_quadChanges.reserve(numberOfSprites);
+	}
+	void shrinkToFit()
+	{
+		m_vertices.resize(m_numberOfVertices);
+		m_vertices.shrink_to_fit();
+		m_batches.shrink_to_fit();
+		m_textures.shrink_to_fit();
+		m_spriteStartVertices.clear();
+		m_spriteStartVertices.shrink_to_fit();
+		m_visibleSpriteIndices.clear();
+		m_visibleSpriteIndices.shrink_to_fit();
+		m_sortItems.clear();
+		m_sortItems.shrink_to_fit();
+		m_sortItemsBuffer.clear();
+		m_sortItemsBuffer.shrink_to_fit();
+		m_spriteVisibilities.clear();
+		m_spriteVisibilities.shrink_to_fit();
+		m_spritePointers.clear();
+		m_spritePointers.shrink_to_fit();
+		m_textureOffsets.clear();
+		m_textureOffsets.shrink_to_fit();
+		m_quadChanges.clear();
+		m_quadChanges.shrink_to_fit();
+		m_changedRanges.clear();
+		m_changedRanges.shrink_to_fit();
+	}
+	// number of sprites that can be batched without allocating vertex storage
+	std::size_t getCapacity() const
+	{
+		return m_vertices.capacity() / 6u;
+	}
+
+	// 0 (default) draws the vertices straight from the batcher's own storage; they are all sent to the graphics driver on every draw
+	// otherwise, the vertices are kept in this many vertex buffers, each batch using the next one in turn (so that the graphics card is not waited for)
+	//     batchSprites compares each quad with the previous batch's and only the parts that have changed are uploaded (when next drawn)
+	//     batchInstances always uploads all of its quads
+	// usage should be Stream (changes most frames) or Dynamic (changes occasionally)
+	// vertex buffers are created and updated when drawn so need an OpenGL context, which any render target provides (including an offscreen sf::RenderTexture)
+	//     if vertex buffers are not available, the vertices are drawn straight from the batcher's own storage
+	void setNumberOfVertexBuffers(const std::size_t numberOfVertexBuffers, const sf::VertexBuffer::Usage usage = sf::VertexBuffer::Usage::Stream)
+	{
+		m_vertexBuffers.clear();
+		m_vertexBuffers.resize(numberOfVertexBuffers, { sf::VertexBuffer(sf::PrimitiveType::Triangles, usage), {}, 0u });
+		m_currentVertexBuffer = 0u;
+	}
+	std::size_t getNumberOfVertexBuffers() const
+	{
+		return m_vertexBuffers.size();
+	}
+	// number of vertices uploaded to a vertex buffer by the most recent draw
+	std::size_t getNumberOfUploadedVertices() const
+	{
+		return m_numberOfUploadedVertices;
 	}
 
 private:
+	struct Batch
+	{
+		const sf::Texture* texture;
+		std::size_t startVertex;
+		std::size_t numberOfVertices;
+	};
+
 	std::vector<sf::Vertex> m_vertices{};
+	std::size_t m_numberOfVertices{ 0u };
+	std::vector<Batch> m_batches{};
+	std::vector<std::size_t> m_spriteStartVertices{};
+	std::vector<const sf::Sprite*> m_spritePointers{};
+	std::vector<const sf::Texture*> m_textures{};
+	std::vector<simpleSpriteBatcher::impl::SortItem> m_sortItems{};
+	std::vector<simpleSpriteBatcher::impl::SortItem> m_sortItemsBuffer{};
+	bool m_isInputOrder{ true };
+	std::unique_ptr<workerPool::WorkerPool> m_workerPool{};
+	Statistics m_statistics{};
+	bool m_isCulling{ false };
+	sf::FloatRect m_visibleRect{};
+	std::vector<unsigned char> m_spriteVisibilities{};
+	std::vector<std::size_t> m_visibleSpriteIndices{};
+	std::vector<sf::Vector2f> m_textureOffsets{}; // how far each sprite's texture coordinates are moved by the texture remap
+
+	struct VertexRange
+	{
+		std::size_t first;
+		std::size_t count;
+	};
+	// a vertex buffer holds a copy of the batcher's first numberOfValidVertices vertices (m_vertices) apart from its dirty ranges
+	//     any vertices after those (e.g. from a larger, earlier batch) are out of date and are never drawn
+	struct VertexBufferSlot
+	{
+		sf::VertexBuffer buffer;
+		std::vector<VertexRange> dirtyRanges;
+		std::size_t numberOfValidVertices;
+	};
+	mutable std::vector<VertexBufferSlot> m_vertexBuffers{};
+	std::size_t m_currentVertexBuffer{ 0u };
+	mutable std::size_t m_numberOfUploadedVertices{ 0u };
+	std::vector<unsigned char> m_quadChanges{};
+	std::vector<VertexRange> m_changedRanges{};
+
+	static constexpr std::size_t maximumNumberOfDirtyRanges{ 64u }; // more than this are combined into one
+	static constexpr std::size_t maximumDirtyRangeGap{ 96u }; // changed quads that are closer than this (in vertices) share a dirty range
+
+	static constexpr std::size_t minimumNumberOfSpritesPerTask{ 4096u };
+
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const
 	{
-		states.texture = texture;
-		target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
-	}
-
-	void setQuad(const sf::Sprite* sprite, std::size_t startVertex)
-	{
-		const sf::Transform transform{ sprite->getTransform() };
-		const sf::Color color{ sprite->getColor() };
-		const sf::IntRect rect{ sprite->getTextureRect() };
-
-		sf::Vector2f shapeTopLeft{ 0.f, 0.f };
-		sf::Vector2f shapeBottomRight(rect.size);
-		sf::Vector2f shapeTopRight{ shapeBottomRight.x, shapeTopLeft.y };
-		sf::Vector2f shapeBottomLeft{ shapeTopLeft.x, shapeBottomRight.y };
-		const sf::Vector2f textureTopLeft(rect.position);
-		const sf::Vector2f textureBottomRight{ textureTopLeft + shapeBottomRight };
-		const sf::Vector2f textureTopRight{ textureBottomRight.x, textureTopLeft.y };
-		const sf::Vector2f textureBottomLeft{ textureTopLeft.x, textureBottomRight.y };
-		shapeTopLeft = transform.transformPoint(shapeTopLeft);
-		shapeBottomRight = transform.transformPoint(shapeBottomRight);
-		shapeTopRight = transform.transformPoint(shapeTopRight);
-		shapeBottomLeft = transform.transformPoint(shapeBottomLeft);
-
-		m_vertices[startVertex + 0u].position = shapeTopLeft;
-		m_vertices[startVertex + 0u].texCoords = textureTopLeft;
-		m_vertices[startVertex + 0u].color = color;
-		m_vertices[startVertex + 1u].position = shapeBottomLeft;
-		m_vertices[startVertex + 1u].texCoords = textureBottomLeft;
-		m_vertices[startVertex + 1u].color = color;
-		m_vertices[startVertex + 2u].position = shapeBottomRight;
-		m_vertices[startVertex + 2u].texCoords = textureBottomRight;
-		m_vertices[startVertex + 2u].color = color;
-		m_vertices[startVertex + 5u].position = shapeTopRight;
-		m_vertices[startVertex + 5u].texCoords = textureTopRight;
-		m_vertices[startVertex + 5u].color = color;
-
-		m_vertices[startVertex + 3u] = m_vertices[startVertex + 0u];
-		m_vertices[startVertex + 4u] = m_vertices[startVertex + 2u];
+		m_numberOfUploadedVertices = 0u;
+		if (m_batches.empty())
+			return;
+		if (!m_vertexBuffers.empty() && sf::VertexBuffer::isAvailable())
+		{
+			VertexBufferSlot& slot{ m_vertexBuffers[m_currentVertexBuffer] };
+			if (uploadVertices(slot))
+			{
+				for (auto& batch : m_batches)
+				{
+					states.texture = batch.texture;
+					target.draw(slot.buffer, batch.startVertex, batch.numberOfVertices, states);
+				}
+				return;
+			}
+		}
+		for (auto& batch : m_batches)
+		{
+			states.texture = batch.texture;
+			target.draw(m_vertices.data() + batch.startVertex, batch.numberOfVertices, sf::PrimitiveType::Triangles, states);
+		}
+	}
+
+	// only the vertices in use (m_numberOfVertices) are uploaded; the buffer is recreated (and they are all uploaded) only when it is too small for them
+	// dirty ranges are only uploaded up to the valid vertices; any vertices in use after those are uploaded together
+	//     if that (including any overlap between dirty ranges) adds up to at least all of the vertices in use, they are uploaded at once instead
+	bool uploadVertices(VertexBufferSlot& slot) const
+	{
+		if (slot.buffer.getVertexCount() < m_numberOfVertices)
+		{
+			slot.dirtyRanges.clear();
+			slot.numberOfValidVertices = 0u;
+			if (!slot.buffer.create(m_numberOfVertices) || !slot.buffer.update(m_vertices.data(), m_numberOfVertices, 0u))
+			{
+				slot.buffer = sf::VertexBuffer(sf::PrimitiveType::Triangles, slot.buffer.getUsage());
+				return false;
+			}
+			slot.numberOfValidVertices = m_numberOfVertices;
+			m_numberOfUploadedVertices = m_numberOfVertices;
+			return true;
+		}
+		const std::size_t numberOfValidVertices{ std::min(slot.numberOfValidVertices, m_numberOfVertices) };
+		std::size_t numberOfDirtyVertices{ m_numberOfVertices - numberOfValidVertices };
+		for (auto& range : slot.dirtyRanges)
+		{
+			if (range.first < numberOfValidVertices)
+				numberOfDirtyVertices += std::min(range.count, numberOfValidVertices - range.first);
+		}
+		if (numberOfDirtyVertices >= m_numberOfVertices)
+		{
+			if (!uploadVertexRange(slot, { 0u, m_numberOfVertices }))
+				return false;
+		}
+		else
+		{
+			for (auto& range : slot.dirtyRanges)
+			{
+				if ((range.first < numberOfValidVertices) && !uploadVertexRange(slot, { range.first, std::min(range.count, numberOfValidVertices - range.first) }))
+					return false;
+			}
+			if ((numberOfValidVertices < m_numberOfVertices) && !uploadVertexRange(slot, { numberOfValidVertices, m_numberOfVertices - numberOfValidVertices }))
+				return false;
+		}
+		slot.dirtyRanges.clear();
+		slot.numberOfValidVertices = m_numberOfVertices;
+		return true;
+	}
+	bool uploadVertexRange(VertexBufferSlot& slot, const VertexRange range) const
+	{
+		if (!slot.buffer.update(m_vertices.data() + range.first, range.count, static_cast<unsigned int>(range.first)))
+		{
+			slot.buffer = sf::VertexBuffer(sf::PrimitiveType::Triangles, slot.buffer.getUsage());
+			slot.dirtyRanges.clear();
+			slot.numberOfValidVertices = 0u;
+			return false;
+		}
+		m_numberOfUploadedVertices += range.count;
+		return true;
+	}
+	// changes are collected in drawing order (positions rather than sprite indices) so that neighbouring changes can share a range
+	void markChangedQuads(const std::size_t numberOfSprites)
+	{
+		m_changedRanges.clear();
+		for (std::size_t position{ 0u }; position < numberOfSprites; ++position)
+		{
+			const std::size_t spriteIndex{ m_isInputOrder ? position : m_sortItems[position].index };
+			if (m_quadChanges[spriteIndex] == 0u)
+				continue;
+			const std::size_t first{ position * 6u };
+			if (!m_changedRanges.empty() && (first <= (m_changedRanges.back().first + m_changedRanges.back().count + maximumDirtyRangeGap)))
+				m_changedRanges.back().count = first + 6u - m_changedRanges.back().first;
+			else
+				m_changedRanges.push_back({ first, 6u });
+		}
+		for (auto& range : m_changedRanges)
+			addDirtyRange(range);
+	}
+	void addDirtyRange(const VertexRange range)
+	{
+		if (range.count == 0u)
+			return;
+		for (auto& slot : m_vertexBuffers)
+		{
+			std::vector<VertexRange>& dirtyRanges{ slot.dirtyRanges };
+			if (dirtyRanges.size() < maximumNumberOfDirtyRanges)
+			{
+				dirtyRanges.push_back(range);
+				continue;
+			}
+			std::size_t first{ range.first };
+			std::size_t end{ range.first + range.count };
+			for (auto& dirtyRange : dirtyRanges)
+			{
+				first = std::min(first, dirtyRange.first);
+				end = std::max(end, dirtyRange.first + dirtyRange.count);
+			}
+			dirtyRanges.clear();
+			dirtyRanges.push_back({ first, end - first });
+		}
+	}
+
+	template <class SpriteRange, class DrawOrderAt, class Projection>
+	void batchSpriteRange(SpriteRange& sprites, DrawOrderAt drawOrderAt, const Projection& projection)
+	{
+		auto first{ std::begin(sprites) };
+		const auto last{ std::end(sprites) };
+		using Iterator = decltype(first);
+		using Projected = decltype(projection(*first));
+		static_assert(std::is_reference_v<Projected> || !std::is_same_v<std::decay_t<Projected>, sf::Sprite>, "projection must return a reference or a pointer to a sprite (not a copy)");
+
+		if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+		{
+			batchSpritesAt(static_cast<std::size_t>(last - first), [&first, &projection](const std::size_t i)
+			{
+				return simpleSpriteBatcher::impl::toSpritePointer(projection(first[static_cast<std::ptrdiff_t>(i)]));
+			}, drawOrderAt);
+		}
+		else
+		{
+			m_spritePointers.clear();
+			for (; first != last; ++first)
+				m_spritePointers.push_back(simpleSpriteBatcher::impl::toSpritePointer(projection(*first)));
+			batchSpritesAt(m_spritePointers.size(), [this](const std::size_t i) { return m_spritePointers[i]; }, drawOrderAt);
+		}
+	}
+
+	template <class SpriteAt, class DrawOrderAt>
+	void batchSpritesAt(const std::size_t numberOfSprites, SpriteAt spriteAt, DrawOrderAt drawOrderAt)
+	{
+		if (!m_isCulling)
+		{
+			writeSprites(numberOfSprites, spriteAt, drawOrderAt);
+			m_statistics = { numberOfSprites, 0u, numberOfSprites, m_batches.size() };
+			return;
+		}
+
+		// visibility is tested in parallel (each sprite has its own flag) and then the visible sprites are collected in order
+		m_spriteVisibilities.resize(numberOfSprites);
+		forEachSpriteRange(numberOfSprites, [this, &spriteAt](const std::size_t begin, const std::size_t end)
+		{
+			for (std::size_t i{ begin }; i < end; ++i)
+				m_spriteVisibilities[i] = isVisible(spriteAt(i)->getGlobalBounds()) ? 1u : 0u;
+		});
+		m_visibleSpriteIndices.clear();
+		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+		{
+			if (m_spriteVisibilities[i] != 0u)
+				m_visibleSpriteIndices.push_back(i);
+		}
+
+		const std::size_t numberOfVisibleSprites{ m_visibleSpriteIndices.size() };
+		writeSprites(numberOfVisibleSprites, [this, &spriteAt](const std::size_t i) { return spriteAt(m_visibleSpriteIndices[i]); }, [this, &drawOrderAt](const std::size_t i) { return drawOrderAt(m_visibleSpriteIndices[i]); });
+		m_statistics = { numberOfSprites, numberOfSprites - numberOfVisibleSprites, numberOfVisibleSprites, m_batches.size() };
+	}
+
+	template <class SpriteAt, class DrawOrderAt>
+	void writeSprites(const std::size_t numberOfSprites, SpriteAt spriteAt, DrawOrderAt drawOrderAt)
+	{
+		prepareVertices(numberOfSprites * 6u);
+		m_batches.clear();
+		if (numberOfSprites == 0u)
+			return;
+
+		const bool isRemapping{ (textureRemap != nullptr) && (texture == nullptr) };
+		if (isRemapping)
+		{
+			m_textureOffsets.resize(numberOfSprites);
+			sortIntoBatches(numberOfSprites, [this, &spriteAt](const std::size_t i)
+			{
+				const sf::Sprite& sprite{ *spriteAt(i) };
+				const sf::Texture* spriteTexture{ &sprite.getTexture() };
+				sf::IntRect textureRect{ sprite.getTextureRect() };
+				const sf::Vector2i originalPosition{ textureRect.position };
+				textureRemap->remap(spriteTexture, textureRect);
+				m_textureOffsets[i] = sf::Vector2f(textureRect.position - originalPosition);
+				return spriteTexture;
+			}, drawOrderAt);
+		}
+		else
+			sortIntoBatches(numberOfSprites, [&spriteAt](const std::size_t i) { return &(spriteAt(i)->getTexture()); }, drawOrderAt);
+
+		// when using vertex buffers, each quad is written separately first so that it can be compared with the previous batch's
+		const bool isTrackingChanges{ !m_vertexBuffers.empty() };
+		if (isTrackingChanges)
+			m_quadChanges.resize(numberOfSprites);
+		const std::size_t* startVertices{ m_isInputOrder ? nullptr : m_spriteStartVertices.data() };
+		forEachSpriteRange(numberOfSprites, [this, &spriteAt, startVertices, isRemapping, isTrackingChanges](const std::size_t begin, const std::size_t end)
+		{
+			sf::Vertex quad[6u];
+			for (std::size_t i{ begin }; i < end; ++i)
+			{
+				sf::Vertex* destination{ m_vertices.data() + ((startVertices == nullptr) ? (i * 6u) : startVertices[i]) };
+				sf::Vertex* vertices{ isTrackingChanges ? quad : destination };
+				simpleSpriteBatcher::impl::setQuad(vertices, *spriteAt(i));
+				if (isRemapping)
+				{
+					for (std::size_t v{ 0u }; v < 6u; ++v)
+						vertices[v].texCoords += m_textureOffsets[i];
+				}
+				if (isTrackingChanges)
+				{
+					const bool isChanged{ std::memcmp(destination, quad, sizeof(quad)) != 0 };
+					m_quadChanges[i] = isChanged ? 1u : 0u;
+					if (isChanged)
+						std::copy(quad, quad + 6u, destination);
+				}
+			}
+		});
+		if (isTrackingChanges)
+		{
+			markChangedQuads(numberOfSprites);
+			m_currentVertexBuffer = (m_currentVertexBuffer + 1u) % m_vertexBuffers.size();
+		}
+	}
+
+	void prepareVertices(const std::size_t numberOfVertices)
+	{
+		if (m_vertices.size() < numberOfVertices)
+			m_vertices.resize(numberOfVertices);
+		m_numberOfVertices = numberOfVertices;
+	}
+
+	bool isVisible(const sf::FloatRect& bounds) const
+	{
+		return (bounds.position.x < (m_visibleRect.position.x + m_visibleRect.size.x)) &&
+			((bounds.position.x + bounds.size.x) > m_visibleRect.position.x) &&
+			(bounds.position.y < (m_visibleRect.position.y + m_visibleRect.size.y)) &&
+			((bounds.position.y + bounds.size.y) > m_visibleRect.position.y);
+	}
+
+	// sorts the sprites (by layer, texture and depth) and creates the batches (a new batch starts whenever the texture changes)
+	// if sorting leaves the sprites in their original order, no start vertices are stored (each sprite's quad starts at its index * 6)
+	template <class TextureAt, class DrawOrderAt>
+	void sortIntoBatches(const std::size_t numberOfSprites, TextureAt textureAt, DrawOrderAt drawOrderAt)
+	{
+		m_isInputOrder = !simpleSpriteBatcher::impl::sortByDrawOrder(numberOfSprites, [this, &textureAt](const std::size_t i) { return (texture != nullptr) ? texture : textureAt(i); }, drawOrderAt, m_textures, m_sortItems, m_sortItemsBuffer);
+		if (m_isInputOrder)
+		{
+			// every sprite has the same key so there is only one texture
+			m_batches.push_back({ m_textures.front(), 0u, numberOfSprites * 6u });
+			return;
+		}
+
+		m_spriteStartVertices.resize(numberOfSprites);
+		for (std::size_t position{ 0u }; position < numberOfSprites; ++position)
+		{
+			const simpleSpriteBatcher::impl::SortItem& item{ m_sortItems[position] };
+			const sf::Texture* batchTexture{ m_textures[simpleSpriteBatcher::impl::getTextureIndexFromSortKey(item.key)] };
+			if (m_batches.empty() || (m_batches.back().texture != batchTexture))
+				m_batches.push_back({ batchTexture, position * 6u, 0u });
+			m_batches.back().numberOfVertices += 6u;
+			m_spriteStartVertices[item.index] = position * 6u;
+		}
+	}
+
+	// each sprite writes to its own quad so the sprites can be split amongst threads in any way
+	// function is called with ranges of sprite indices: [begin, end)
+	template <class Function>
+	void forEachSpriteRange(const std::size_t numberOfSprites, Function function)
+	{
+		const std::size_t numberOfThreads{ getNumberOfThreads() };
+		if ((numberOfThreads == 1u) || (numberOfSprites < (minimumNumberOfSpritesPerTask * 2u)))
+		{
+			function(std::size_t{ 0u }, numberOfSprites);
+			return;
+		}
+
+		const std::size_t numberOfTasks{ std::min(numberOfThreads * 4u, numberOfSprites / minimumNumberOfSpritesPerTask) };
+		auto task{ [numberOfSprites, numberOfTasks, &function](const std::size_t taskIndex)
+		{
+			function((numberOfSprites * taskIndex) / numberOfTasks, (numberOfSprites * (taskIndex + 1u)) / numberOfTasks);
+		} };
+		m_workerPool->run(numberOfTasks, task);
 	}
 };
 
@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////////
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023-2026 M.J.Silk
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//
+//       ------------
+//       INTRODUCTION
+//       ------------
+//
+//   Measures how quickly the simple sprite batcher batches sprites without opening a window (nothing is drawn).
+//   This measures CPU time only so it can be run on machines without a GPU (or a display).
+//   Each test batches the same sprites repeatedly and records:
+//     - time per sprite (nanoseconds): the mean and the fastest batch
+//     - bytes of vertices written per batch
+//     - allocations per batch (after the first batch; the batcher should not allocate once its storage has grown)
+//     - draw calls per batch
+//   Tests are run for 5k, 50k, 100k, 250k, 500k and 1000k sprites with these workloads:
+//     - static: the sprites do not change between batches
+//     - rotating: every sprite is rotated before each batch (the rotation is not included in the time)
+//   and with these inputs:
+//     - vector: batchSprites(std::vector<sf::Sprite>)
+//     - pointers: batchSprites(std::vector<sf::Sprite*>)
+//   The results are written as CSV (with a header line), one line per test.
+//
+//
+//       -----
+//       USAGE
+//       -----
+//
+//   SimpleSpriteBatcher_benchmark [output file] [number of threads]
+//
+//   The results are written to the output file if one is given, otherwise to the standard output.
+//   The number of threads is passed to the batcher's setNumberOfThreads (default is 1; 0 uses all of the hardware's threads).
+//
+//
+//       -------------
+//       CUSTOMISATION
+//       -------------
+//
+//   You can change the numbers of sprites tested using this line: constexpr std::size_t numbersOfSprites[]{ ... };
+//   You can change how many sprites are batched (in total) by each test using this line: constexpr std::size_t numberOfSpritesPerTest{ 10000000u };
+//
+//
+//        ----
+//        NOTE
+//        ----
+//
+//    No texture is loaded (and no OpenGL context is needed); the sprites use an empty texture and are given texture rects directly.
+//    Global operator new is replaced to count allocations so this should be its own executable.
+//    You may also need to adjust the path of the included header ("SimpleSpriteBatcher.hpp") depending on your approach.
+//    Remember to build in release mode. Results in debug mode are not meaningful.
+//
+//    This benchmark is for use with SFML 3.
+//
+//
+////////////////////////////////////////////////////////////////
+
+
+
+#include <SFML/Graphics.hpp>
+
+#include "../SimpleSpriteBatcher/SimpleSpriteBatcher.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+
+
+// allocation counting
+namespace
+{
+
+std::atomic<std::size_t> numberOfAllocations{ 0u };
+
+} // namespace
+
+void* operator new(const std::size_t size)
+{
+	++numberOfAllocations;
+	if (void* memory{ std::malloc((size == 0u) ? 1u : size) })
+		return memory;
+	throw std::bad_alloc{};
+}
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+
+
+namespace
+{
+
+enum class Workload
+{
+	Static,
+	Rotating,
+};
+
+enum class Input
+{
+	Vector,
+	Pointers,
+};
+
+struct Result
+{
+	std::size_t numberOfIterations;
+	double meanNanosecondsPerSprite;
+	double minimumNanosecondsPerSprite;
+	std::size_t bytesWritten;
+	double allocationsPerBatch;
+	std::size_t numberOfDrawCalls;
+};
+
+void createSprites(std::vector<sf::Sprite>& sprites, const std::size_t numberOfSprites, const sf::Texture& texture)
+{
+	std::srand(0u); // same sprites every time
+	sprites.clear();
+	sprites.resize(numberOfSprites, sf::Sprite(texture));
+	for (auto& sprite : sprites)
+	{
+		const std::size_t randomTileIndex{ std::rand() % 16u };
+		sprite.setTextureRect({ { (static_cast<int>(randomTileIndex) % 4) * 4, (static_cast<int>(randomTileIndex) / 4) * 4 }, { 4, 4 } });
+		const float scale{ ((std::rand() % 950) + 50) / 100.f };
+		sprite.setScale({ scale , scale });
+		sprite.setPosition({ static_cast<float>(std::rand() % 1920), static_cast<float>(std::rand() % 1080) });
+		sprite.setRotation(sf::degrees((std::rand() % 1000) * 0.36f));
+	}
+}
+
+template <class SpriteRange>
+Result runTest(SimpleSpriteBatcher& batcher, std::vector<sf::Sprite>& sprites, const SpriteRange& spriteRange, const Workload workload, const std::size_t numberOfIterations)
+{
+	// first batch grows the batcher's storage (not measured)
+	batcher.batchSprites(spriteRange);
+
+	double totalNanoseconds{ 0.0 };
+	double minimumNanoseconds{ 0.0 };
+	std::size_t totalAllocations{ 0u };
+	for (std::size_t iteration{ 0u }; iteration < numberOfIterations; ++iteration)
+	{
+		if (workload == Workload::Rotating)
+		{
+			for (auto& sprite : sprites)
+				sprite.rotate(sf::degrees(2.f));
+		}
+
+		const std::size_t allocationsBefore{ numberOfAllocations };
+		const auto start{ std::chrono::steady_clock::now() };
+		batcher.batchSprites(spriteRange);
+		const auto end{ std::chrono::steady_clock::now() };
+		totalAllocations += numberOfAllocations - allocationsBefore;
+
+		const double nanoseconds{ std::chrono::duration<double, std::nano>(end - start).count() };
+		totalNanoseconds += nanoseconds;
+		if ((iteration == 0u) || (nanoseconds < minimumNanoseconds))
+			minimumNanoseconds = nanoseconds;
+	}
+
+	const double numberOfSprites{ static_cast<double>(sprites.size()) };
+	const SimpleSpriteBatcher::Statistics statistics{ batcher.getStatistics() };
+	return
+	{
+		numberOfIterations,
+		totalNanoseconds / (numberOfSprites * numberOfIterations),
+		minimumNanoseconds / numberOfSprites,
+		statistics.numberOfBatchedSprites * 6u * sizeof(sf::Vertex),
+		static_cast<double>(totalAllocations) / numberOfIterations,
+		statistics.numberOfDrawCalls,
+	};
+}
+
+} // namespace
+
+
+
+int main(int argc, char* argv[])
+{
+	constexpr std::size_t numbersOfSprites[]{ 5000u, 50000u, 100000u, 250000u, 500000u, 1000000u };
+	constexpr std::size_t numberOfSpritesPerTest{ 10000000u }; // each test batches (at least) this many sprites in total
+	constexpr std::size_t minimumNumberOfIterations{ 5u };
+
+	std::ofstream file;
+	if (argc > 1)
+	{
+		file.open(argv[1]);
+		if (!file)
+		{
+			std::cerr << "Unable to open " << argv[1] << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	std::ostream& output{ file.is_open() ? static_cast<std::ostream&>(file) : std::cout };
+	const std::size_t numberOfThreads{ (argc > 2) ? static_cast<std::size_t>(std::strtoul(argv[2], nullptr, 10)) : 1u };
+
+
+
+	const sf::Texture texture; // never uploaded or bound so no OpenGL context is needed
+	std::vector<sf::Sprite> sprites;
+	std::vector<sf::Sprite*> spritePointers;
+	SimpleSpriteBatcher batcher;
+	batcher.setNumberOfThreads(numberOfThreads);
+
+	output << "sprites,workload,input,threads,iterations,mean_ns_per_sprite,min_ns_per_sprite,bytes_written,allocations_per_batch,draw_calls\n";
+	for (const std::size_t numberOfSprites : numbersOfSprites)
+	{
+		const std::size_t numberOfIterations{ std::max(minimumNumberOfIterations, numberOfSpritesPerTest / numberOfSprites) };
+		for (const Workload workload : { Workload::Static, Workload::Rotating })
+		{
+			for (const Input input : { Input::Vector, Input::Pointers })
+			{
+				createSprites(sprites, numberOfSprites, texture);
+				spritePointers.clear();
+				for (auto& sprite : sprites)
+					spritePointers.push_back(&sprite);
+
+				const Result result{ (input == Input::Vector) ? runTest(batcher, sprites, sprites, workload, numberOfIterations) : runTest(batcher, sprites, spritePointers, workload, numberOfIterations) };
+				output << numberOfSprites << ','
+					<< ((workload == Workload::Static) ? "static" : "rotating") << ','
+					<< ((input == Input::Vector) ? "vector" : "pointers") << ','
+					<< batcher.getNumberOfThreads() << ','
+					<< result.numberOfIterations << ','
+					<< result.meanNanosecondsPerSprite << ','
+					<< result.minimumNanosecondsPerSprite << ','
+					<< result.bytesWritten << ','
+					<< result.allocationsPerBatch << ','
+					<< result.numberOfDrawCalls << '\n';
+				output.flush();
+			}
+		}
+	}
+}
@@ -38,13 +38,16 @@
 //   If the batcher is used, all of the sprites are batches every frame and then drawn together as one.
 //   This is a simple batcher that should always be no slower than drawing them separately but likely to have improvements, usually significant.
 //   The batcher can more than double the frame-rate at lower frame-rates (when drawing is the biggest issue)
+//   Sprites can use different textures; the batcher groups them by texture and uses one draw call per texture.
+//   The batcher can also be asynchronous (AsyncSpriteBatcher): the next frame is batched on a background thread while the current one is drawn and displayed.
+//     This shows the sprites one frame late but allows batching and drawing to overlap.
 //
 //
 //       --------
 //       CONTROLS
 //       --------
 //
-//   SPACE			        toggle batcher (starts off)
+//   SPACE			        cycle batcher (off, on, asynchronous) (starts off)
 //   ESC                    quit
 // 
 // 
@@ -53,6 +56,9 @@
 //       -------------
 //
 //   You can (should) change the number of sprites ('n') created (but not too many!) so that they lower your frame-rate using this line: sprites.resize('n', sf::Sprite(texture));
+//   You can change the number of threads used by the batcher using this line: batcher.setNumberOfThreads(1u); (it is only worth it for large numbers of sprites)
+//   You can have the batcher draw from vertex buffers (only uploading the parts that change) using this line: batcher.setNumberOfVertexBuffers(0u); (try 2u or 3u)
+//     Since every sprite is rotated every frame in this example, every part changes so all of the vertices are still uploaded each frame.
 //
 //
 //        ----
@@ -62,7 +68,8 @@
 //    If the window is too large (1920u, 1080u) for your resolution, you can uncomment the following define line to halve the window size (to 960x540): #define HALVE_WINDOW_SIZE
 //    If you'd like to push the window size a little larger (2880, 1620)!, you can uncomment: #define LARGER_WINDOW_SIZE. Note that halving the size affects this value as well.
 //    The texture is available in the resources folder, which is in the root folder. You may need to adjust the path.
-//    You may also need to adjust the path of the included header ("SimpleSpriteBatcher.hpp") depending on your approach.
+//    You may also need to adjust the path of the included headers ("SimpleSpriteBatcher.hpp" and "AsyncSpriteBatcher.hpp") depending on your approach.
+//    "SimpleSpriteBatcher.hpp" includes "WorkerPool.hpp" from the WorkerPool folder (in the root folder).
 //    Remember to test in both debug and release modes for comparisons. The batcher may be less effective in debug mode.
 // 
 //    This example is for use with SFML 3.
@@ -75,6 +82,7 @@
 #include <SFML/Graphics.hpp>
 
 #include "../SimpleSpriteBatcher/SimpleSpriteBatcher.hpp"
+#include "../SimpleSpriteBatcher/AsyncSpriteBatcher.hpp"
 
 
 
@@ -121,13 +129,20 @@ int main()
 
 
 	// batcher (Simple Sprite Batcher)
-	SimpleSpriteBatcher batcher;
-	batcher.texture = &texture;
+	SimpleSpriteBatcher batcher; // sprites are grouped by their own textures so no texture needs to be set here
+	batcher.setNumberOfThreads(1u); // 1 batches on this thread only. 0 uses all of the hardware's threads
+	batcher.setNumberOfVertexBuffers(0u); // 0 draws the vertices directly. more than 0 keeps them in that many vertex buffers (used in turn)
+	AsyncSpriteBatcher asyncBatcher; // batches on its own background thread
 
 
 
-	// flag to determine whether to use batcher or not. this can be toggled by pressing SPACE
-	bool useBatcher{ false };
+	// which batcher to use (if any). this can be cycled by pressing SPACE
+	enum class Method
+	{
+		Separate,
+		Batcher,
+		AsyncBatcher,
+	} method{ Method::Separate };
 
 
 
@@ -135,25 +150,44 @@ int main()
 	sf::RenderWindow window(sf::VideoMode(windowSize), "");
 	while (window.isOpen())
 	{
+		// the asynchronous batcher must finish reading the sprites before they can be updated
+		asyncBatcher.finishBatching();
+
 		// update sprites
 		for (std::size_t i{ 0u }; i < sprites.size(); ++i)
 			sprites[i].rotate(sf::degrees(2.f));
 
-		// batch sprites
-		if (useBatcher)
+		// batch sprites (the asynchronous batcher only starts batching here; it continues while the previous batch is drawn)
+		switch (method)
+		{
+		case Method::Batcher:
 			batcher.batchSprites(sprites);
+			break;
+		case Method::AsyncBatcher:
+			asyncBatcher.batchSprites(sprites);
+			break;
+		case Method::Separate:
+			break;
+		}
 
 		// show trivial FPS in window title
-		window.setTitle(std::string("BATCHER ") + (useBatcher ? "ON:             " : "OFF:            ") + std::to_string(static_cast<int>(1.f / clock.restart().asSeconds())) + "\tFPS");
+		const std::string methodName{ (method == Method::Separate) ? "OFF:            " : (method == Method::Batcher) ? "ON:             " : "ASYNC:          " };
+		window.setTitle("BATCHER " + methodName + std::to_string(static_cast<int>(1.f / clock.restart().asSeconds())) + "\tFPS");
 
 		// render
 		window.clear();
-		if (useBatcher)
-			window.draw(batcher);
-		else
+		switch (method)
 		{
+		case Method::Batcher:
+			window.draw(batcher);
+			break;
+		case Method::AsyncBatcher:
+			window.draw(asyncBatcher);
+			break;
+		case Method::Separate:
 			for (auto& sprite : sprites)
 				window.draw(sprite);
+			break;
 		}
 		window.display();
 
@@ -170,7 +204,7 @@ int main()
 					window.close();
 					break;
 				case sf::Keyboard::Key::Space:
-					useBatcher = !useBatcher;
+					method = (method == Method::Separate) ? Method::Batcher : (method == Method::Batcher) ? Method::AsyncBatcher : Method::Separate;
 					break;
 				}
 			}
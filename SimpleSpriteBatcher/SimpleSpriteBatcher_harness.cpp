@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////////
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023-2026 M.J.Silk
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//
+//       ------------
+//       INTRODUCTION
+//       ------------
+//
+//   Checks that drawing the simple sprite batcher from vertex buffers (see setNumberOfVertexBuffers) gives exactly the same pixels as drawing its vertices directly.
+//   No window is opened; two batchers (one with vertex buffers and one without) batch the same sprites and each draws into its own sf::RenderTexture.
+//   The two render textures are then copied into images and compared pixel by pixel.
+//   A sequence of frames is drawn (each changing the sprites in a different way) so that every vertex buffer is reused many times:
+//     - static: nothing changes
+//     - move: a few sprites are moved (so only parts of the vertex buffers are updated)
+//     - rotate: every sprite is rotated
+//     - shrink: fewer sprites are batched than in the previous frame
+//     - grow: more sprites are batched than in the previous frame
+//     - reorder: the sprites are given draw orders (so they are sorted)
+//     - cull: only the sprites in one part of the render texture are batched
+//     - instances: the sprites are batched as the batcher's own sprite instances (batchInstances)
+//   Each frame also checks that no more vertices were uploaded than are in use.
+//   Once every vertex buffer has only seen static and move frames since it was last drawn, fewer vertices than are in use must be uploaded (only the changed parts).
+//   The results are written as CSV (with a header line), one line per frame.
+//   The exit code is EXIT_SUCCESS only if every frame matched.
+//
+//
+//       -----
+//       USAGE
+//       -----
+//
+//   SimpleSpriteBatcher_harness [output file] [number of frames]
+//
+//   The results are written to the output file if one is given, otherwise to the standard output.
+//   The number of frames defaults to 64.
+//
+//
+//       -------------
+//       CUSTOMISATION
+//       -------------
+//
+//   You can change the largest number of sprites using this line: constexpr std::size_t maximumNumberOfSprites{ 3000u };
+//   You can change the number of vertex buffers using this line: constexpr std::size_t numberOfVertexBuffers{ 3u };
+//
+//
+//        ----
+//        NOTE
+//        ----
+//
+//    An OpenGL context is needed (for the render textures and vertex buffers) but no display is; a software renderer (e.g. Mesa's llvmpipe) is enough.
+//    If vertex buffers are not available, the check fails (since it would only be comparing the batcher with itself).
+//    You may also need to adjust the path of the included header ("SimpleSpriteBatcher.hpp") depending on your approach.
+//
+//    This harness is for use with SFML 3.
+//
+//
+////////////////////////////////////////////////////////////////
+
+
+
+#include <SFML/Graphics.hpp>
+
+#include "../SimpleSpriteBatcher/SimpleSpriteBatcher.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+constexpr sf::Vector2u targetSize{ 256u, 256u };
+
+enum class Change
+{
+	Static,
+	Move,
+	Rotate,
+	Shrink,
+	Grow,
+	Reorder,
+	Cull,
+	Instances,
+};
+
+// runs of static and move frames (at least as long as the number of vertex buffers) check that only the changed parts are uploaded
+constexpr Change changes[]{ Change::Static, Change::Move, Change::Static, Change::Move, Change::Rotate, Change::Shrink, Change::Move, Change::Grow, Change::Static, Change::Move, Change::Static, Change::Reorder, Change::Move, Change::Cull, Change::Grow, Change::Instances, Change::Shrink, Change::Rotate };
+
+std::string getChangeName(const Change change)
+{
+	switch (change)
+	{
+	case Change::Static:
+		return "static";
+	case Change::Move:
+		return "move";
+	case Change::Rotate:
+		return "rotate";
+	case Change::Shrink:
+		return "shrink";
+	case Change::Grow:
+		return "grow";
+	case Change::Reorder:
+		return "reorder";
+	case Change::Cull:
+		return "cull";
+	case Change::Instances:
+	default:
+		return "instances";
+	}
+}
+
+// 4x4 tiles of different colours (the second texture's colours are reversed) so that wrong texture coordinates or textures are visible
+bool createTexture(sf::Texture& texture, const bool isReversed)
+{
+	sf::Image image({ 16u, 16u }, sf::Color::White);
+	for (unsigned int y{ 0u }; y < 16u; ++y)
+	{
+		for (unsigned int x{ 0u }; x < 16u; ++x)
+		{
+			const std::uint8_t tileIndex{ static_cast<std::uint8_t>(((y / 4u) * 4u) + (x / 4u)) };
+			const std::uint8_t value{ static_cast<std::uint8_t>(isReversed ? (255u - (tileIndex * 16u)) : (tileIndex * 16u)) };
+			image.setPixel({ x, y }, { value, static_cast<std::uint8_t>(255u - value), static_cast<std::uint8_t>((x + y) * 8u), 255u });
+		}
+	}
+	return texture.loadFromImage(image);
+}
+
+void randomizeSprite(sf::Sprite& sprite)
+{
+	const int randomTileIndex{ std::rand() % 16 };
+	sprite.setTextureRect({ { (randomTileIndex % 4) * 4, (randomTileIndex / 4) * 4 }, { 4, 4 } });
+	sprite.setOrigin({ 2.f, 2.f });
+	const float scale{ ((std::rand() % 300) + 100) / 100.f };
+	sprite.setScale({ scale, scale });
+	sprite.setPosition({ static_cast<float>(std::rand() % targetSize.x), static_cast<float>(std::rand() % targetSize.y) });
+	sprite.setRotation(sf::degrees((std::rand() % 1000) * 0.36f));
+	sprite.setColor({ static_cast<std::uint8_t>(std::rand() % 256), static_cast<std::uint8_t>(std::rand() % 256), static_cast<std::uint8_t>(std::rand() % 256), static_cast<std::uint8_t>(128 + (std::rand() % 128)) });
+}
+
+template <class Batch>
+std::size_t drawAndCompare(SimpleSpriteBatcher& batcher, SimpleSpriteBatcher& vertexBufferBatcher, sf::RenderTexture& target, sf::RenderTexture& vertexBufferTarget, const Batch& batch)
+{
+	batch(batcher);
+	batch(vertexBufferBatcher);
+	target.clear();
+	target.draw(batcher);
+	target.display();
+	vertexBufferTarget.clear();
+	vertexBufferTarget.draw(vertexBufferBatcher);
+	vertexBufferTarget.display();
+
+	const sf::Image image{ target.getTexture().copyToImage() };
+	const sf::Image vertexBufferImage{ vertexBufferTarget.getTexture().copyToImage() };
+	std::size_t numberOfMismatchedPixels{ 0u };
+	for (unsigned int y{ 0u }; y < targetSize.y; ++y)
+	{
+		for (unsigned int x{ 0u }; x < targetSize.x; ++x)
+		{
+			if (image.getPixel({ x, y }) != vertexBufferImage.getPixel({ x, y }))
+				++numberOfMismatchedPixels;
+		}
+	}
+	return numberOfMismatchedPixels;
+}
+
+} // namespace
+
+
+
+int main(int argc, char* argv[])
+{
+	constexpr std::size_t maximumNumberOfSprites{ 3000u };
+	constexpr std::size_t numberOfVertexBuffers{ 3u };
+
+	std::ofstream file;
+	if (argc > 1)
+	{
+		file.open(argv[1]);
+		if (!file)
+		{
+			std::cerr << "Unable to open " << argv[1] << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	std::ostream& output{ file.is_open() ? static_cast<std::ostream&>(file) : std::cout };
+	const std::size_t numberOfFrames{ (argc > 2) ? static_cast<std::size_t>(std::strtoul(argv[2], nullptr, 10)) : 64u };
+
+
+
+	sf::RenderTexture target;
+	sf::RenderTexture vertexBufferTarget;
+	if (!target.resize(targetSize) || !vertexBufferTarget.resize(targetSize))
+	{
+		std::cerr << "Unable to create render textures" << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (!sf::VertexBuffer::isAvailable())
+	{
+		std::cerr << "Vertex buffers are not available" << std::endl;
+		return EXIT_FAILURE;
+	}
+	sf::Texture textures[2u];
+	if (!createTexture(textures[0u], false) || !createTexture(textures[1u], true))
+	{
+		std::cerr << "Unable to create textures" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::srand(0u); // same sprites every time
+	std::vector<sf::Sprite> sprites(maximumNumberOfSprites, sf::Sprite(textures[0u]));
+	for (std::size_t i{ 0u }; i < maximumNumberOfSprites; ++i)
+	{
+		sprites[i].setTexture(textures[i % 2u]);
+		randomizeSprite(sprites[i]);
+	}
+	std::vector<simpleSpriteBatcher::DrawOrder> drawOrders(maximumNumberOfSprites);
+
+	SimpleSpriteBatcher batcher;
+	SimpleSpriteBatcher vertexBufferBatcher;
+	vertexBufferBatcher.setNumberOfVertexBuffers(numberOfVertexBuffers);
+
+	bool isIdentical{ true };
+	std::size_t numberOfPartialFrames{ 0u }; // consecutive static and move frames (the first frame uploads everything so is not one)
+	std::size_t numberOfSprites{ maximumNumberOfSprites };
+	output << "frame,change,sprites,vertices_in_use,uploaded_vertices,partial_upload_expected,mismatched_pixels\n";
+	for (std::size_t frame{ 0u }; frame < numberOfFrames; ++frame)
+	{
+		// the first frame uploads everything
+		const Change change{ (frame == 0u) ? Change::Static : changes[frame % std::size(changes)] };
+		batcher.clearVisibleRect();
+		vertexBufferBatcher.clearVisibleRect();
+		bool isUsingDrawOrders{ false };
+		switch (change)
+		{
+		case Change::Move:
+			for (std::size_t i{ 0u }; i < numberOfSprites; i += 97u)
+				sprites[i].move({ 3.f, -2.f });
+			break;
+		case Change::Rotate:
+			for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+				sprites[i].rotate(sf::degrees(5.f));
+			break;
+		case Change::Shrink:
+			numberOfSprites = (numberOfSprites / 3u) + 1u;
+			break;
+		case Change::Grow:
+			numberOfSprites = std::min(maximumNumberOfSprites, (numberOfSprites * 2u) + 7u);
+			break;
+		case Change::Reorder:
+			for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+				drawOrders[i] = { static_cast<std::int16_t>(std::rand() % 3), static_cast<float>(std::rand() % 100) };
+			isUsingDrawOrders = true;
+			break;
+		case Change::Cull:
+			batcher.setVisibleRect(sf::FloatRect({ 0.f, 0.f }, { targetSize.x / 2.f, targetSize.y * 1.f }));
+			vertexBufferBatcher.setVisibleRect(sf::FloatRect({ 0.f, 0.f }, { targetSize.x / 2.f, targetSize.y * 1.f }));
+			break;
+		case Change::Static:
+		case Change::Instances:
+		default:
+			break;
+		}
+
+		const std::vector<sf::Sprite> frameSprites(sprites.begin(), sprites.begin() + static_cast<std::ptrdiff_t>(numberOfSprites));
+		const std::vector<simpleSpriteBatcher::DrawOrder> frameDrawOrders(drawOrders.begin(), drawOrders.begin() + static_cast<std::ptrdiff_t>(numberOfSprites));
+		const std::size_t numberOfMismatchedPixels{ drawAndCompare(batcher, vertexBufferBatcher, target, vertexBufferTarget, [&](SimpleSpriteBatcher& spriteBatcher)
+		{
+			if (change == Change::Instances)
+			{
+				spriteBatcher.instances.clear();
+				for (auto& sprite : frameSprites)
+					spriteBatcher.instances.add(sprite);
+				spriteBatcher.batchInstances();
+			}
+			else if (isUsingDrawOrders)
+				spriteBatcher.batchSprites(frameSprites, frameDrawOrders);
+			else
+				spriteBatcher.batchSprites(frameSprites);
+		}) };
+
+		const std::size_t numberOfVerticesInUse{ vertexBufferBatcher.getStatistics().numberOfBatchedSprites * 6u };
+		const std::size_t numberOfUploadedVertices{ vertexBufferBatcher.getNumberOfUploadedVertices() };
+		numberOfPartialFrames = ((frame != 0u) && ((change == Change::Static) || (change == Change::Move))) ? (numberOfPartialFrames + 1u) : 0u;
+		// the vertex buffer being drawn holds the changes of the most recent numberOfVertexBuffers batches
+		const bool isPartialUploadExpected{ numberOfPartialFrames >= numberOfVertexBuffers };
+		if ((numberOfMismatchedPixels != 0u) || (numberOfUploadedVertices > numberOfVerticesInUse) || (isPartialUploadExpected && (numberOfUploadedVertices >= numberOfVerticesInUse)))
+			isIdentical = false;
+		output << frame << ','
+			<< getChangeName(change) << ','
+			<< numberOfSprites << ','
+			<< numberOfVerticesInUse << ','
+			<< numberOfUploadedVertices << ','
+			<< (isPartialUploadExpected ? "yes" : "no") << ','
+			<< numberOfMismatchedPixels << '\n';
+		output.flush();
+	}
+
+	std::cerr << (isIdentical ? "PASS" : "FAIL") << std::endl;
+	return isIdentical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
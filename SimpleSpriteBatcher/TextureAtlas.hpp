@@ -0,0 +1,296 @@
+#ifndef HAPAXIA_SFMLSNIPPETS_TEXTURE_ATLAS
+#define HAPAXIA_SFMLSNIPPETS_TEXTURE_ATLAS
+
+#include "SimpleSpriteBatcher.hpp"
+#include <deque>
+#include <unordered_map>
+
+// packs images (or parts of images or textures) into one or more atlas pages (textures) at runtime
+// regions are placed using a skyline (bottom-left) packer; larger regions are placed first
+// each region is surrounded by padding which, if 'extrudeEdges' is set, is filled with copies of the region's edge pixels
+//     this stops neighbouring regions bleeding in when the texture is smoothed or drawn at fractional positions
+// a region added from a texture (or with its source texture given) remaps that texture:
+//     any texture rect that is entirely within the region's original rect is translated to the matching rect on the atlas page
+// the atlas can be used as a simple sprite batcher's texture remap (batcher.textureRemap = &atlas) so that sprites that use
+//     many different textures are batched (and drawn) as if they all used the atlas pages
+// alternatively, applyTo changes a sprite's texture and texture rect to the atlas page and rect directly
+// nothing is packed (and no remapping happens) until build is called; build must be called again after adding more regions
+//     page textures keep their addresses when rebuilt (unless there are fewer pages than before)
+class TextureAtlas : public simpleSpriteBatcher::TextureRemap
+{
+public:
+	struct Region
+	{
+		std::size_t page;
+		sf::IntRect rect; // rect on the page (does not include the padding)
+	};
+
+	sf::Vector2u pageSize{ 2048u, 2048u };
+	unsigned int padding{ 1u }; // pixels on each side of each region
+	bool extrudeEdges{ true };
+
+	TextureAtlas() = default;
+	// each of these returns the id of the new region (ids are given in order, starting at zero)
+	// an empty rect (the default) means the entire image or texture
+	std::size_t addImage(const sf::Image& image, const sf::IntRect& rect = {})
+	{
+		return addSource(image, rect, nullptr);
+	}
+	// the image should contain the source texture's pixels (e.g. the image it was loaded from); sprites using the source texture (within the rect) are remapped
+	std::size_t addImage(const sf::Image& image, const sf::IntRect& rect, const sf::Texture& sourceTexture)
+	{
+		return addSource(image, rect, &sourceTexture);
+	}
+	// copies the texture's pixels back from the graphics card; sprites using the texture (within the rect) are remapped
+	std::size_t addTexture(const sf::Texture& texture, const sf::IntRect& rect = {})
+	{
+		return addSource(texture.copyToImage(), rect, &texture);
+	}
+	void clear()
+	{
+		m_sources.clear();
+		m_sourceIdsByTexture.clear();
+		m_pages.clear();
+		m_isBuilt = false;
+	}
+	// returns false if a region (plus padding) is larger than a page or if a page texture could not be created
+	bool build()
+	{
+		m_isBuilt = false;
+
+		// larger regions first (by height and then by width); the sort is stable so the result is always the same
+		std::vector<std::size_t> order(m_sources.size());
+		for (std::size_t i{ 0u }; i < order.size(); ++i)
+			order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [this](const std::size_t a, const std::size_t b)
+		{
+			const sf::Vector2i sizeA{ m_sources[a].textureRect.size };
+			const sf::Vector2i sizeB{ m_sources[b].textureRect.size };
+			return (sizeA.y != sizeB.y) ? (sizeA.y > sizeB.y) : (sizeA.x > sizeB.x);
+		});
+
+		const sf::Vector2i pageSizeInt(pageSize);
+		const int paddingInt{ static_cast<int>(padding) };
+		std::vector<std::vector<SkylineSegment>> skylines;
+		for (auto& sourceId : order)
+		{
+			Source& source{ m_sources[sourceId] };
+			const sf::Vector2i paddedSize{ source.textureRect.size.x + (paddingInt * 2), source.textureRect.size.y + (paddingInt * 2) };
+			if ((paddedSize.x > pageSizeInt.x) || (paddedSize.y > pageSizeInt.y))
+				return false;
+
+			sf::Vector2i position{};
+			std::size_t segmentIndex{ 0u };
+			std::size_t page{ 0u };
+			for (; page < skylines.size(); ++page)
+			{
+				if (findSkylinePosition(skylines[page], paddedSize, position, segmentIndex))
+					break;
+			}
+			if (page == skylines.size())
+			{
+				skylines.push_back({ { 0, 0, pageSizeInt.x } });
+				findSkylinePosition(skylines.back(), paddedSize, position, segmentIndex);
+			}
+			addSkylineLevel(skylines[page], segmentIndex, position, paddedSize);
+			source.region = { page, { { position.x + paddingInt, position.y + paddingInt }, source.textureRect.size } };
+		}
+
+		// pages
+		std::vector<sf::Image> pageImages(skylines.size(), sf::Image(pageSize, sf::Color::Transparent));
+		for (auto& source : m_sources)
+			writeRegion(pageImages[source.region.page], source);
+		m_pages.resize(pageImages.size());
+		for (std::size_t i{ 0u }; i < pageImages.size(); ++i)
+		{
+			if (!m_pages[i].loadFromImage(pageImages[i]))
+				return false;
+		}
+
+		m_isBuilt = true;
+		return true;
+	}
+	bool isBuilt() const
+	{
+		return m_isBuilt;
+	}
+	std::size_t getNumberOfRegions() const
+	{
+		return m_sources.size();
+	}
+	std::size_t getNumberOfPages() const
+	{
+		return m_pages.size();
+	}
+	const sf::Texture& getPage(const std::size_t pageIndex) const
+	{
+		return m_pages[pageIndex];
+	}
+	// only valid once built
+	Region getRegion(const std::size_t regionId) const
+	{
+		return m_sources[regionId].region;
+	}
+	// translates a texture and texture rect to an atlas page and rect (if the rect is entirely within a region added from that texture)
+	bool remap(const sf::Texture*& texture, sf::IntRect& textureRect) const override
+	{
+		if (!m_isBuilt)
+			return false;
+		const auto sourceIds{ m_sourceIdsByTexture.find(texture) };
+		if (sourceIds == m_sourceIdsByTexture.end())
+			return false;
+
+		// texture rects can be flipped (negative size)
+		const sf::Vector2i rectMin{ std::min(textureRect.position.x, textureRect.position.x + textureRect.size.x), std::min(textureRect.position.y, textureRect.position.y + textureRect.size.y) };
+		const sf::Vector2i rectMax{ std::max(textureRect.position.x, textureRect.position.x + textureRect.size.x), std::max(textureRect.position.y, textureRect.position.y + textureRect.size.y) };
+		for (auto& sourceId : sourceIds->second)
+		{
+			const Source& source{ m_sources[sourceId] };
+			const sf::IntRect& sourceRect{ source.textureRect };
+			if ((rectMin.x < sourceRect.position.x) || (rectMin.y < sourceRect.position.y) || (rectMax.x > (sourceRect.position.x + sourceRect.size.x)) || (rectMax.y > (sourceRect.position.y + sourceRect.size.y)))
+				continue;
+			texture = &m_pages[source.region.page];
+			textureRect.position += source.region.rect.position - sourceRect.position;
+			return true;
+		}
+		return false;
+	}
+	// changes the sprite's texture and texture rect to the atlas page and rect (if its texture and texture rect are remapped)
+	bool applyTo(sf::Sprite& sprite) const
+	{
+		const sf::Texture* spriteTexture{ &sprite.getTexture() };
+		sf::IntRect textureRect{ sprite.getTextureRect() };
+		if (!remap(spriteTexture, textureRect))
+			return false;
+		sprite.setTexture(*spriteTexture);
+		sprite.setTextureRect(textureRect);
+		return true;
+	}
+
+private:
+	struct Source
+	{
+		sf::Image image; // only the pixels of the region
+		sf::IntRect textureRect; // original rect in the source image/texture
+		Region region;
+	};
+	// a horizontal part of the skyline: the top of everything placed below it
+	struct SkylineSegment
+	{
+		int x;
+		int y;
+		int width;
+	};
+
+	std::vector<Source> m_sources{};
+	std::unordered_map<const sf::Texture*, std::vector<std::size_t>> m_sourceIdsByTexture{};
+	std::deque<sf::Texture> m_pages{};
+	bool m_isBuilt{ false };
+
+	std::size_t addSource(const sf::Image& image, sf::IntRect rect, const sf::Texture* sourceTexture)
+	{
+		if ((rect.size.x == 0) || (rect.size.y == 0))
+			rect = { { 0, 0 }, sf::Vector2i(image.getSize()) };
+		sf::Image regionImage(sf::Vector2u(rect.size), sf::Color::Transparent);
+		if (!regionImage.copy(image, { 0u, 0u }, rect))
+			regionImage = sf::Image(sf::Vector2u(rect.size), sf::Color::Transparent);
+
+		const std::size_t sourceId{ m_sources.size() };
+		m_sources.push_back({ regionImage, rect, { 0u, {} } });
+		if (sourceTexture != nullptr)
+			m_sourceIdsByTexture[sourceTexture].push_back(sourceId);
+		m_isBuilt = false;
+		return sourceId;
+	}
+
+	// finds the lowest position (then the left-most) on the skyline that fits the size
+	// segmentIndex is the segment at which the size's left edge starts
+	bool findSkylinePosition(const std::vector<SkylineSegment>& skyline, const sf::Vector2i size, sf::Vector2i& position, std::size_t& segmentIndex) const
+	{
+		const sf::Vector2i pageSizeInt(pageSize);
+		bool isFound{ false };
+		int bestBottom{ 0 };
+		for (std::size_t i{ 0u }; i < skyline.size(); ++i)
+		{
+			const int x{ skyline[i].x };
+			if ((x + size.x) > pageSizeInt.x)
+				break;
+			int y{ 0 };
+			int remainingWidth{ size.x };
+			for (std::size_t j{ i }; remainingWidth > 0; ++j)
+			{
+				y = std::max(y, skyline[j].y);
+				remainingWidth -= skyline[j].width;
+			}
+			const int bottom{ y + size.y };
+			if ((bottom > pageSizeInt.y) || (isFound && (bottom >= bestBottom)))
+				continue;
+			isFound = true;
+			bestBottom = bottom;
+			position = { x, y };
+			segmentIndex = i;
+		}
+		return isFound;
+	}
+	void addSkylineLevel(std::vector<SkylineSegment>& skyline, const std::size_t segmentIndex, const sf::Vector2i position, const sf::Vector2i size) const
+	{
+		skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(segmentIndex), { position.x, position.y + size.y, size.x });
+
+		// remove (or shorten) the segments now covered by the new one
+		const int right{ position.x + size.x };
+		const std::size_t nextIndex{ segmentIndex + 1u };
+		while ((nextIndex < skyline.size()) && (skyline[nextIndex].x < right))
+		{
+			SkylineSegment& segment{ skyline[nextIndex] };
+			const int segmentRight{ segment.x + segment.width };
+			if (segmentRight <= right)
+			{
+				skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(nextIndex));
+				continue;
+			}
+			segment.width = segmentRight - right;
+			segment.x = right;
+			break;
+		}
+
+		// merge neighbouring segments at the same height
+		for (std::size_t i{ 1u }; i < skyline.size();)
+		{
+			if (skyline[i - 1u].y == skyline[i].y)
+			{
+				skyline[i - 1u].width += skyline[i].width;
+				skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i));
+			}
+			else
+				++i;
+		}
+	}
+
+	void writeRegion(sf::Image& pageImage, const Source& source) const
+	{
+		const sf::Vector2u position(source.region.rect.position);
+		const sf::Vector2i size{ source.region.rect.size };
+		if (!pageImage.copy(source.image, position))
+			return;
+		if (!extrudeEdges || (padding == 0u) || (size.x <= 0) || (size.y <= 0))
+			return;
+
+		// each padding pixel copies the nearest edge pixel of the region
+		const int paddingInt{ static_cast<int>(padding) };
+		for (int y{ -paddingInt }; y < (size.y + paddingInt); ++y)
+		{
+			const unsigned int sourceY{ static_cast<unsigned int>(std::clamp(y, 0, size.y - 1)) };
+			for (int x{ -paddingInt }; x < (size.x + paddingInt); ++x)
+			{
+				if ((x == 0) && (y >= 0) && (y < size.y))
+					x = size.x; // skip the region itself
+				if (x >= (size.x + paddingInt))
+					break;
+				const unsigned int sourceX{ static_cast<unsigned int>(std::clamp(x, 0, size.x - 1)) };
+				pageImage.setPixel({ static_cast<unsigned int>(static_cast<int>(position.x) + x), static_cast<unsigned int>(static_cast<int>(position.y) + y) }, source.image.getPixel({ sourceX, sourceY }));
+			}
+		}
+	}
+};
+
+#endif // HAPAXIA_SFMLSNIPPETS_TEXTURE_ATLAS
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023-2026 M.J.Silk
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//
+//       ------------
+//       INTRODUCTION
+//       ------------
+//
+//   Splits a texture into sixteen separate textures (one for each of its coloured tiles).
+//   Creates a large vector of sprites, each using one of those textures (chosen randomly).
+//   They are (trivially) randomly placed, scaled and rotated.
+//   Each frame, all of them are rotated by a set amount. The frame-rate will affect their speed.
+//   All of the sprites are batched every frame by the simple sprite batcher.
+//   Without the atlas, the batcher groups the sprites by texture and needs a draw call for each texture (sixteen).
+//   With the atlas, the sixteen textures are packed (at runtime) into a single atlas page and the batcher uses the atlas to remap each sprite's texture.
+//     All of the sprites are then drawn with a single draw call. The sprites themselves are not changed.
+//   The window title shows the number of draw calls.
+//
+//
+//       --------
+//       CONTROLS
+//       --------
+//
+//   SPACE			        toggle atlas (starts off)
+//   ESC                    quit
+// 
+// 
+//       -------------
+//       CUSTOMISATION
+//       -------------
+//
+//   You can (should) change the number of sprites ('n') created (but not too many!) so that they lower your frame-rate using this line: sprites.resize('n', sf::Sprite(textures.front()));
+//   You can change the padding around each region in the atlas using this line: atlas.padding = 1u;
+//
+//
+//        ----
+//        NOTE
+//        ----
+//
+//    If the window is too large (1920u, 1080u) for your resolution, you can uncomment the following define line to halve the window size (to 960x540): #define HALVE_WINDOW_SIZE
+//    The texture is available in the resources folder, which is in the root folder. You may need to adjust the path.
+//    You may also need to adjust the path of the included headers ("SimpleSpriteBatcher.hpp" and "TextureAtlas.hpp") depending on your approach.
+//    Remember to test in both debug and release modes for comparisons. The batcher may be less effective in debug mode.
+// 
+//    This example is for use with SFML 3.
+//
+//
+////////////////////////////////////////////////////////////////
+
+
+
+#include <SFML/Graphics.hpp>
+
+#include "../SimpleSpriteBatcher/SimpleSpriteBatcher.hpp"
+#include "../SimpleSpriteBatcher/TextureAtlas.hpp"
+
+#include <deque>
+
+
+
+//#define HALVE_WINDOW_SIZE
+
+
+
+int main()
+{
+	sf::Vector2u windowSize{ 1920u, 1080u };
+#ifdef HALVE_WINDOW_SIZE
+	windowSize /= 2u;
+#endif // HALVE_WINDOW_SIZE
+
+
+
+	// image (split into separate textures)
+	sf::Image image;
+	if (!image.loadFromFile("resources/images/16colours(16x16_4x4each)-tex.png"))
+		return EXIT_FAILURE;
+	std::deque<sf::Texture> textures(16u); // deque keeps the textures at the same addresses (sprites and the atlas refer to them)
+	for (std::size_t i{ 0u }; i < textures.size(); ++i)
+	{
+		if (!textures[i].loadFromImage(image, false, { { (static_cast<int>(i) % 4) * 4, (static_cast<int>(i) / 4) * 4 }, { 4, 4 } }))
+			return EXIT_FAILURE;
+	}
+
+
+
+	// atlas
+	TextureAtlas atlas;
+	atlas.pageSize = { 256u, 256u };
+	atlas.padding = 1u;
+	for (std::size_t i{ 0u }; i < textures.size(); ++i)
+		atlas.addImage(image, { { (static_cast<int>(i) % 4) * 4, (static_cast<int>(i) / 4) * 4 }, { 4, 4 } }, textures[i]); // the image region that each texture was loaded from (avoids copying the textures back from the graphics card)
+	if (!atlas.build())
+		return EXIT_FAILURE;
+
+
+
+	// sprites
+	std::vector<sf::Sprite> sprites;
+	sprites.resize(100000u, sf::Sprite(textures.front())); // change this to a value that is affects your frame-rate. this will be different on every system.
+	for (auto& sprite : sprites)
+	{
+		sprite.setTexture(textures[rand() % textures.size()], true);
+		const float scale{ ((rand() % 950) + 50) / 100.f };
+		sprite.setScale({ scale , scale });
+		sprite.setPosition({ static_cast<float>(rand() % windowSize.x), static_cast<float>(rand() % windowSize.y) });
+		sprite.setRotation(sf::degrees((rand() % 1000) * 0.36f));
+	}
+
+
+
+	// batcher
+	SimpleSpriteBatcher batcher;
+
+
+
+	// flag to determine whether to use the atlas or not. this can be toggled by pressing SPACE
+	bool useAtlas{ false };
+
+
+
+	sf::Clock clock; // clock for measuring FPS
+	sf::RenderWindow window(sf::VideoMode(windowSize), "");
+	while (window.isOpen())
+	{
+		// update sprites
+		for (auto& sprite : sprites)
+			sprite.rotate(sf::degrees(2.f));
+
+		// batch sprites
+		batcher.textureRemap = useAtlas ? &atlas : nullptr;
+		batcher.batchSprites(sprites);
+
+		// show trivial FPS in window title
+		window.setTitle(std::string("ATLAS ") + (useAtlas ? "ON" : "OFF") + " (" + std::to_string(batcher.getNumberOfDrawCalls()) + " draw calls):     " + std::to_string(static_cast<int>(1.f / clock.restart().asSeconds())) + "\tFPS");
+
+		// render
+		window.clear();
+		window.draw(batcher);
+		window.display();
+
+		// events
+		while (const auto event{ window.pollEvent() })
+		{
+			if (event->is<sf::Event::Closed>())
+				window.close();
+			else if (const auto keyPressed{ event->getIf<sf::Event::KeyPressed>() })
+			{
+				switch (keyPressed->code)
+				{
+				case sf::Keyboard::Key::Escape:
+					window.close();
+					break;
+				case sf::Keyboard::Key::Space:
+					useAtlas = !useAtlas;
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,212 @@
+#ifndef HAPAXIA_SFMLSNIPPETS_TILE_MAP_BATCHER
+#define HAPAXIA_SFMLSNIPPETS_TILE_MAP_BATCHER
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// batcher for a grid of tiles (a tile map) that only stores a tile index (two bytes) for each tile
+// tiles are taken from a tileset texture: tile index i is the i-th tile of the tileset (left to right, then top to bottom)
+// tile positions are implicit: the tile at (column, row) is at (column * tileSize.x, row * tileSize.y) before the map's transform
+// only the tiles visible in the view given to update are batched; these are kept in a "window" of quads that wraps around in both directions
+//     when the view scrolls, only the quads of the columns and rows that have entered the window are rewritten
+//     the window is rewritten entirely when its size changes (i.e. the view's size, zoom or rotation changes)
+// empty tiles (emptyTile) are written as quads with no area
+// all visible tiles are drawn with a single draw call
+class TileMapBatcher : public sf::Drawable, public sf::Transformable
+{
+public:
+	static constexpr std::uint16_t emptyTile{ 0xFFFFu };
+
+	TileMapBatcher() = default;
+	// changing the tileset or the map size clears the window so nothing is drawn until the next update
+	void setTileset(const sf::Texture& texture, const sf::Vector2u tileSize)
+	{
+		m_texture = &texture;
+		m_tileSize = tileSize;
+		m_tilesetColumns = (tileSize.x == 0u) ? 0u : (texture.getSize().x / tileSize.x);
+		m_numberOfTilesetTiles = (tileSize.y == 0u) ? 0u : (m_tilesetColumns * (texture.getSize().y / tileSize.y));
+		clearWindow();
+	}
+	// resizing the map empties all of its tiles
+	void setMapSize(const sf::Vector2u mapSize)
+	{
+		m_mapSize = mapSize;
+		m_tiles.assign(static_cast<std::size_t>(mapSize.x) * mapSize.y, emptyTile);
+		clearWindow();
+	}
+	sf::Vector2u getMapSize() const
+	{
+		return m_mapSize;
+	}
+	void setTile(const sf::Vector2u tileCoord, const std::uint16_t tile)
+	{
+		if ((tileCoord.x >= m_mapSize.x) || (tileCoord.y >= m_mapSize.y))
+			return;
+		m_tiles[getTileIndex(tileCoord)] = tile;
+		if (m_isWindowValid && isInWindow(tileCoord))
+			writeTile(tileCoord);
+	}
+	std::uint16_t getTile(const sf::Vector2u tileCoord) const
+	{
+		if ((tileCoord.x >= m_mapSize.x) || (tileCoord.y >= m_mapSize.y))
+			return emptyTile;
+		return m_tiles[getTileIndex(tileCoord)];
+	}
+	// tiles must contain (at least) one tile for each tile in the map; rows are stored one after the other (top to bottom)
+	void setTiles(const std::uint16_t* tiles)
+	{
+		std::copy(tiles, tiles + m_tiles.size(), m_tiles.begin());
+		m_isWindowValid = false;
+	}
+	void fill(const std::uint16_t tile)
+	{
+		std::fill(m_tiles.begin(), m_tiles.end(), tile);
+		m_isWindowValid = false;
+	}
+	// prepares the tiles visible in the view (taking into account the map's transform)
+	void update(const sf::View& view)
+	{
+		m_numberOfRewrittenTiles = 0u;
+		if ((m_mapSize.x == 0u) || (m_mapSize.y == 0u) || (m_tileSize.x == 0u) || (m_tileSize.y == 0u))
+		{
+			clearWindow();
+			return;
+		}
+
+		// visible area in the map's (untransformed) coordinates
+		sf::Transform viewRotation;
+		viewRotation.rotate(view.getRotation(), view.getCenter());
+		const sf::FloatRect visibleRect{ getInverseTransform().transformRect(viewRotation.transformRect({ view.getCenter() - (view.getSize() / 2.f), view.getSize() })) };
+		const sf::Vector2f tileSize(m_tileSize);
+
+		// the window is large enough to cover the visible area at any position
+		const sf::Vector2u windowSize{ std::min(m_mapSize.x, static_cast<unsigned int>(std::ceil(visibleRect.size.x / tileSize.x)) + 1u), std::min(m_mapSize.y, static_cast<unsigned int>(std::ceil(visibleRect.size.y / tileSize.y)) + 1u) };
+		const sf::Vector2i maximumWindowPosition{ sf::Vector2i(m_mapSize - windowSize) };
+		const sf::Vector2i windowPosition{ std::clamp(static_cast<int>(std::floor(visibleRect.position.x / tileSize.x)), 0, maximumWindowPosition.x), std::clamp(static_cast<int>(std::floor(visibleRect.position.y / tileSize.y)), 0, maximumWindowPosition.y) };
+
+		if (!m_isWindowValid || (windowSize != m_windowSize))
+		{
+			m_windowSize = windowSize;
+			m_windowPosition = windowPosition;
+			m_vertices.resize(static_cast<std::size_t>(windowSize.x) * windowSize.y * 6u);
+			writeTiles({ windowPosition, sf::Vector2i(windowSize) });
+			m_isWindowValid = true;
+			return;
+		}
+
+		// columns and rows that have entered the window (the corners where they cross may be written twice)
+		const sf::Vector2i previousWindowPosition{ m_windowPosition };
+		m_windowPosition = windowPosition;
+		const sf::Vector2i windowSizeInt(windowSize);
+		const int columnShift{ windowPosition.x - previousWindowPosition.x };
+		const int rowShift{ windowPosition.y - previousWindowPosition.y };
+		if ((std::abs(columnShift) >= windowSizeInt.x) || (std::abs(rowShift) >= windowSizeInt.y))
+		{
+			writeTiles({ windowPosition, windowSizeInt });
+			return;
+		}
+		if (columnShift > 0)
+			writeTiles({ { previousWindowPosition.x + windowSizeInt.x, windowPosition.y }, { columnShift, windowSizeInt.y } });
+		else if (columnShift < 0)
+			writeTiles({ { windowPosition.x, windowPosition.y }, { -columnShift, windowSizeInt.y } });
+		if (rowShift > 0)
+			writeTiles({ { windowPosition.x, previousWindowPosition.y + windowSizeInt.y }, { windowSizeInt.x, rowShift } });
+		else if (rowShift < 0)
+			writeTiles({ { windowPosition.x, windowPosition.y }, { windowSizeInt.x, -rowShift } });
+	}
+	// statistics of the most recent update
+	std::size_t getNumberOfRewrittenTiles() const
+	{
+		return m_numberOfRewrittenTiles;
+	}
+	sf::Vector2u getWindowSize() const
+	{
+		return m_windowSize;
+	}
+
+private:
+	const sf::Texture* m_texture{ nullptr };
+	sf::Vector2u m_tileSize{ 0u, 0u };
+	unsigned int m_tilesetColumns{ 0u };
+	unsigned int m_numberOfTilesetTiles{ 0u };
+	sf::Vector2u m_mapSize{ 0u, 0u };
+	std::vector<std::uint16_t> m_tiles{};
+	bool m_isWindowValid{ false };
+	sf::Vector2u m_windowSize{ 0u, 0u };
+	sf::Vector2i m_windowPosition{ 0, 0 }; // top-left tile of the window
+	std::vector<sf::Vertex> m_vertices{};
+	std::size_t m_numberOfRewrittenTiles{ 0u };
+
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const
+	{
+		if ((m_texture == nullptr) || m_vertices.empty())
+			return;
+		states.transform *= getTransform();
+		states.texture = m_texture;
+		target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+	}
+
+	// the old window's quads would use the old tileset or map size
+	void clearWindow()
+	{
+		m_windowSize = { 0u, 0u };
+		m_vertices.clear();
+		m_isWindowValid = false;
+	}
+	std::size_t getTileIndex(const sf::Vector2u tileCoord) const
+	{
+		return (static_cast<std::size_t>(tileCoord.y) * m_mapSize.x) + tileCoord.x;
+	}
+	bool isInWindow(const sf::Vector2u tileCoord) const
+	{
+		const sf::Vector2i coord(tileCoord);
+		return (coord.x >= m_windowPosition.x) && (coord.x < (m_windowPosition.x + static_cast<int>(m_windowSize.x))) &&
+			(coord.y >= m_windowPosition.y) && (coord.y < (m_windowPosition.y + static_cast<int>(m_windowSize.y)));
+	}
+	void writeTiles(const sf::IntRect& tileRect)
+	{
+		for (int y{ tileRect.position.y }; y < (tileRect.position.y + tileRect.size.y); ++y)
+		{
+			for (int x{ tileRect.position.x }; x < (tileRect.position.x + tileRect.size.x); ++x)
+				writeTile(sf::Vector2u(sf::Vector2i{ x, y }));
+		}
+	}
+	// each tile always uses the same quad of the window (its coordinate wrapped by the window size)
+	void writeTile(const sf::Vector2u tileCoord)
+	{
+		++m_numberOfRewrittenTiles;
+		sf::Vertex* vertices{ m_vertices.data() + (((static_cast<std::size_t>(tileCoord.y % m_windowSize.y) * m_windowSize.x) + (tileCoord.x % m_windowSize.x)) * 6u) };
+		const std::uint16_t tile{ m_tiles[getTileIndex(tileCoord)] };
+		if (tile >= m_numberOfTilesetTiles)
+		{
+			for (std::size_t v{ 0u }; v < 6u; ++v)
+				vertices[v] = sf::Vertex{};
+			return;
+		}
+
+		const sf::Vector2f tileSize(m_tileSize);
+		const sf::Vector2f topLeft{ tileCoord.x * tileSize.x, tileCoord.y * tileSize.y };
+		const sf::Vector2f bottomRight{ topLeft + tileSize };
+		const sf::Vector2f textureTopLeft{ (tile % m_tilesetColumns) * tileSize.x, (tile / m_tilesetColumns) * tileSize.y };
+		const sf::Vector2f textureBottomRight{ textureTopLeft + tileSize };
+
+		vertices[0u].position = topLeft;
+		vertices[0u].texCoords = textureTopLeft;
+		vertices[1u].position = { topLeft.x, bottomRight.y };
+		vertices[1u].texCoords = { textureTopLeft.x, textureBottomRight.y };
+		vertices[2u].position = bottomRight;
+		vertices[2u].texCoords = textureBottomRight;
+		vertices[5u].position = { bottomRight.x, topLeft.y };
+		vertices[5u].texCoords = { textureBottomRight.x, textureTopLeft.y };
+		for (auto v : { 0u, 1u, 2u, 5u })
+			vertices[v].color = sf::Color::White;
+
+		vertices[3u] = vertices[0u];
+		vertices[4u] = vertices[2u];
+	}
+};
+
+#endif // HAPAXIA_SFMLSNIPPETS_TILE_MAP_BATCHER
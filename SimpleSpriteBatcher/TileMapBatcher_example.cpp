@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023-2026 M.J.Silk
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//
+//       ------------
+//       INTRODUCTION
+//       ------------
+//
+//   Creates a very large tile map (4096x4096 tiles) with (trivially) random tiles.
+//   The tiles come from a tileset texture with sixteen coloured tiles.
+//   Each tile is stored as just its tile index (two bytes) rather than as a sprite. The map's tile indices use 32 MB in total.
+//   Only the tiles that are visible are batched and, when the view scrolls, only the columns and rows that come into view are rewritten.
+//   The map is scaled up so that each tile is large enough to see.
+//   The window title shows how many tiles were rewritten in the last frame.
+//
+//
+//       --------
+//       CONTROLS
+//       --------
+//
+//   ARROWS                 scroll view
+//   Z                      zoom in
+//   X                      zoom out
+//   ESC                    quit
+// 
+// 
+//       -------------
+//       CUSTOMISATION
+//       -------------
+//
+//   You can change the size of the map using this line: constexpr sf::Vector2u mapSize{ 4096u, 4096u };
+//   You can change the scale of the map using this line: tileMap.setScale({ 8.f, 8.f });
+//
+//
+//        ----
+//        NOTE
+//        ----
+//
+//    If the window is too large (1920u, 1080u) for your resolution, you can uncomment the following define line to halve the window size (to 960x540): #define HALVE_WINDOW_SIZE
+//    The texture is available in the resources folder, which is in the root folder. You may need to adjust the path.
+//    You may also need to adjust the path of the included header ("TileMapBatcher.hpp") depending on your approach.
+// 
+//    This example is for use with SFML 3.
+//
+//
+////////////////////////////////////////////////////////////////
+
+
+
+#include <SFML/Graphics.hpp>
+
+#include "../SimpleSpriteBatcher/TileMapBatcher.hpp"
+
+
+
+//#define HALVE_WINDOW_SIZE
+
+
+
+int main()
+{
+	sf::Vector2u windowSize{ 1920u, 1080u };
+#ifdef HALVE_WINDOW_SIZE
+	windowSize /= 2u;
+#endif // HALVE_WINDOW_SIZE
+
+
+
+	// texture (tileset)
+	sf::Texture texture;
+	if (!texture.loadFromFile("resources/images/16colours(16x16_4x4each)-tex.png"))
+		return EXIT_FAILURE;
+
+
+
+	// tile map
+	constexpr sf::Vector2u mapSize{ 4096u, 4096u };
+	std::vector<std::uint16_t> tiles(static_cast<std::size_t>(mapSize.x) * mapSize.y);
+	for (auto& tile : tiles)
+		tile = static_cast<std::uint16_t>(rand() % 17); // 16 is not in the tileset so is empty
+	TileMapBatcher tileMap;
+	tileMap.setTileset(texture, { 4u, 4u });
+	tileMap.setMapSize(mapSize);
+	tileMap.setTiles(tiles.data());
+	tileMap.setScale({ 8.f, 8.f });
+
+
+
+	constexpr float scrollSpeed{ 1000.f }; // pixels per second
+	constexpr float zoomSpeed{ 1.f }; // doubles per second
+	sf::Clock clock; // clock for measuring FPS (and scrolling)
+	sf::RenderWindow window(sf::VideoMode(windowSize), "");
+	sf::View view{ window.getDefaultView() };
+	while (window.isOpen())
+	{
+		const float frameTime{ clock.restart().asSeconds() };
+
+		// scroll and zoom view
+		sf::Vector2f scroll{ 0.f, 0.f };
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left))
+			scroll.x -= 1.f;
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right))
+			scroll.x += 1.f;
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up))
+			scroll.y -= 1.f;
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down))
+			scroll.y += 1.f;
+		const float zoom{ view.getSize().x / window.getDefaultView().getSize().x };
+		view.move(scroll * scrollSpeed * zoom * frameTime);
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Z))
+			view.zoom(std::pow(2.f, -zoomSpeed * frameTime));
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::X))
+			view.zoom(std::pow(2.f, zoomSpeed * frameTime));
+		window.setView(view);
+
+		// update tile map (only for the visible tiles)
+		tileMap.update(view);
+
+		// show trivial FPS in window title
+		window.setTitle("TILES REWRITTEN: " + std::to_string(tileMap.getNumberOfRewrittenTiles()) + "     " + std::to_string(static_cast<int>(1.f / frameTime)) + "\tFPS");
+
+		// render
+		window.clear();
+		window.draw(tileMap);
+		window.display();
+
+		// events
+		while (const auto event{ window.pollEvent() })
+		{
+			if (event->is<sf::Event::Closed>())
+				window.close();
+			else if (const auto keyPressed{ event->getIf<sf::Event::KeyPressed>() })
+			{
+				switch (keyPressed->code)
+				{
+				case sf::Keyboard::Key::Escape:
+					window.close();
+					break;
+				}
+			}
+		}
+	}
+}
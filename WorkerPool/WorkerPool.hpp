@@ -0,0 +1,98 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace workerPool
+{
+
+// a fixed set of threads that, along with the calling thread, work through a number of tasks
+// run() blocks until every task has been completed
+class WorkerPool
+{
+public:
+	explicit WorkerPool(const std::size_t numberOfAdditionalThreads)
+	{
+		m_threads.reserve(numberOfAdditionalThreads);
+		for (std::size_t i{ 0u }; i < numberOfAdditionalThreads; ++i)
+			m_threads.emplace_back([this]() { work(); });
+	}
+	~WorkerPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_startCondition.notify_all();
+		for (auto& thread : m_threads)
+			thread.join();
+	}
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+	std::size_t getNumberOfThreads() const
+	{
+		return m_threads.size() + 1u;
+	}
+	// task is called once for each task index in [0, numberOfTasks)
+	template <class Task>
+	void run(const std::size_t numberOfTasks, Task& task)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			m_task = &task;
+			m_runTask = [](void* taskPointer, const std::size_t taskIndex) { (*static_cast<Task*>(taskPointer))(taskIndex); };
+			m_numberOfTasks = numberOfTasks;
+			m_nextTaskIndex = 0u;
+			m_numberOfBusyThreads = m_threads.size();
+			++m_generation;
+		}
+		m_startCondition.notify_all();
+		runTasks();
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneCondition.wait(lock, [this]() { return m_numberOfBusyThreads == 0u; });
+	}
+
+private:
+	std::vector<std::thread> m_threads{};
+	std::mutex m_mutex{};
+	std::condition_variable m_startCondition{};
+	std::condition_variable m_doneCondition{};
+	void* m_task{ nullptr };
+	void (*m_runTask)(void*, std::size_t) { nullptr };
+	std::size_t m_numberOfTasks{ 0u };
+	std::atomic<std::size_t> m_nextTaskIndex{ 0u };
+	std::size_t m_numberOfBusyThreads{ 0u };
+	std::size_t m_generation{ 0u };
+	bool m_isStopping{ false };
+
+	void runTasks()
+	{
+		for (std::size_t taskIndex{ m_nextTaskIndex++ }; taskIndex < m_numberOfTasks; taskIndex = m_nextTaskIndex++)
+			m_runTask(m_task, taskIndex);
+	}
+	void work()
+	{
+		std::size_t generation{ 0u };
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_startCondition.wait(lock, [this, generation]() { return m_isStopping || (m_generation != generation); });
+			if (m_isStopping)
+				return;
+			generation = m_generation;
+			lock.unlock();
+			runTasks();
+			lock.lock();
+			if (--m_numberOfBusyThreads == 0u)
+				m_doneCondition.notify_one();
+		}
+	}
+};
+
+} // namespace workerPool
+#endif // WORKER_POOL_HPP